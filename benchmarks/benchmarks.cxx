@@ -0,0 +1,374 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+
+// Time the common drawing, font, blit and flush operations on every
+// kind of pixel container, with displays sending to an in-process bus
+// instead of hardware.
+//
+//     benchmarks [-t seconds] [filter]
+//
+// Each benchmark runs for at least the given time (default 0.2 seconds)
+// and only those whose name contains filter are run. The results are
+// written to standard output as CSV, one line per benchmark, with the
+// time per operation in nanoseconds and, for displays, the bytes put on
+// the wire per operation (see OledBusModel).
+
+#include <getopt.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "OledBitmap.h"
+#include "OledDisplay.h"
+#include "OledEmulator.h"
+#include "OledFont8x16.h"
+#include "OledGraphics.h"
+#include "OledI2CEmulatorDevice.h"
+#include "OledI2CFakeDevice.h"
+#include "OledI2CTransport.h"
+#include "OledMeteredTransport.h"
+#include "OledSurface.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr int Width{128};
+constexpr int Height{64};
+constexpr int Points{1024};
+
+using Clock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------
+
+// A display on an I2C bus that goes nowhere, or into an emulator, with
+// its traffic metered.
+
+class BenchmarkDisplay
+{
+public:
+
+    explicit BenchmarkDisplay(std::unique_ptr<SSD1306::OledI2CDevice> device)
+    :
+        metered_{new SSD1306::OledMeteredTransport{
+                     std::make_unique<SSD1306::OledI2CTransport>(
+                         std::move(device)),
+                     SSD1306::OledBusModel::i2c()}},
+        display_{std::unique_ptr<SSD1306::OledTransport>(metered_)}
+    {
+    }
+
+    SSD1306::OledDisplay& display() { return display_; }
+    SSD1306::OledMeteredTransport& metered() { return *metered_; }
+
+private:
+
+    SSD1306::OledMeteredTransport* metered_;
+    SSD1306::OledDisplay display_;
+};
+
+//-------------------------------------------------------------------------
+
+class Benchmarks
+{
+public:
+
+    Benchmarks(
+        double seconds,
+        const std::string& filter)
+    :
+        minimum_{seconds},
+        filter_{filter}
+    {
+        std::cout << "benchmark,ns_per_op,wire_bytes_per_op,ops\n";
+    }
+
+    // Run op in ever larger batches until a batch takes at least the
+    // minimum time, then report that batch. For displays, metered gives
+    // the bytes put on the wire.
+
+    void
+    run(
+        const std::string& name,
+        std::function<void(uint64_t)> op,
+        SSD1306::OledMeteredTransport* metered = nullptr)
+    {
+        if (name.find(filter_) == std::string::npos)
+        {
+            return;
+        }
+
+        op(0);
+
+        uint64_t ops{1};
+        std::chrono::duration<double> elapsed{0};
+
+        for (;;)
+        {
+            if (metered)
+            {
+                metered->resetStats();
+            }
+
+            auto start = Clock::now();
+
+            for (uint64_t i = 0 ; i < ops ; ++i)
+            {
+                op(i);
+            }
+
+            elapsed = Clock::now() - start;
+
+            if (elapsed.count() >= minimum_)
+            {
+                break;
+            }
+
+            ops *= 2;
+        }
+
+        double wireBytes = metered ? metered->stats().wireBytes : 0;
+
+        std::cout << name << ","
+                  << (elapsed.count() * 1e9) / ops << ","
+                  << wireBytes / ops << ","
+                  << ops << "\n";
+    }
+
+private:
+
+    double minimum_;
+    std::string filter_;
+};
+
+//-------------------------------------------------------------------------
+
+void
+usage(
+    const char* name)
+{
+    std::cerr << "Usage: " << name << " [-t seconds] [filter]\n";
+    std::cerr << "\n";
+    std::cerr << "    -t - minimum time for each benchmark (default 0.2)\n";
+    std::cerr << "\n";
+    std::cerr << "only benchmarks whose name contains filter are run\n";
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    double seconds{0.2};
+
+    int opt;
+
+    while ((opt = ::getopt(argc, argv, "t:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 't':
+
+            seconds = std::strtod(optarg, nullptr);
+            break;
+
+        default:
+
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind > 1)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Benchmarks benchmarks{seconds, (optind < argc) ? argv[optind] : ""};
+
+    std::mt19937 generator;
+    std::vector<SSD1306::OledPoint> points;
+
+    for (auto i = 0 ; i < Points ; ++i)
+    {
+        points.push_back(SSD1306::OledPoint{int(generator() % Width),
+                                            int(generator() % Height)});
+    }
+
+    auto point = [&points](uint64_t i) { return points[i % Points]; };
+
+    SSD1306::OledBitmap<Width, Height> rowBitmap;
+    SSD1306::OledBitmap<Width, Height, SSD1306::OledLayout::PageMajor>
+        pageBitmap;
+    SSD1306::OledSurface surface{Width, Height};
+    BenchmarkDisplay null{std::make_unique<SSD1306::OledI2CFakeDevice>()};
+
+    SSD1306::OledEmulator emulator;
+    BenchmarkDisplay emulated{
+        std::make_unique<SSD1306::OledI2CEmulatorDevice>(emulator)};
+
+    struct Container
+    {
+        std::string name;
+        SSD1306::OledPixel& pixels;
+    };
+
+    std::vector<Container> containers{{"rowBitmap", rowBitmap},
+                                      {"pageBitmap", pageBitmap},
+                                      {"surface", surface},
+                                      {"display", null.display()}};
+
+    //---------------------------------------------------------------------
+
+    for (auto& c : containers)
+    {
+        auto& pixels = c.pixels;
+
+        benchmarks.run("line/" + c.name,
+                       [&](uint64_t i)
+                       {
+                           SSD1306::line(point(i),
+                                         point(i + 1),
+                                         SSD1306::PixelStyle::Xor,
+                                         pixels);
+                       });
+
+        benchmarks.run("boxFilled/" + c.name,
+                       [&](uint64_t i)
+                       {
+                           SSD1306::boxFilled(point(i),
+                                              point(i + 1),
+                                              SSD1306::PixelStyle::Xor,
+                                              pixels);
+                       });
+
+        benchmarks.run("drawString8x16/" + c.name,
+                       [&](uint64_t i)
+                       {
+                           SSD1306::drawString8x16(point(i),
+                                                   "Benchmark",
+                                                   SSD1306::PixelStyle::Set,
+                                                   pixels);
+                       });
+    }
+
+    for (auto& to : containers)
+    {
+        for (auto& from : containers)
+        {
+            benchmarks.run("setFrom/" + to.name + "/" + from.name,
+                           [&](uint64_t)
+                           {
+                               to.pixels.setFrom(from.pixels);
+                           });
+        }
+    }
+
+    //---------------------------------------------------------------------
+
+    auto& display = null.display();
+
+    // A byte of each copy is stored to keep the copy from being dropped.
+
+    volatile uint8_t kept{0};
+
+    benchmarks.run("getBitmap/display",
+                   [&](uint64_t i)
+                   {
+                       auto bitmap = display.getBitmap();
+                       kept = bitmap.raster().bytes[i % Width];
+                   });
+
+    // clear() and fill() are OledDisplay::fillWith().
+
+    benchmarks.run("fillWith/display",
+                   [&](uint64_t i)
+                   {
+                       if (i % 2)
+                       {
+                           display.fill();
+                       }
+                       else
+                       {
+                           display.clear();
+                       }
+                   });
+
+    // Every frame changes every page, or a single pixel.
+
+    for (auto d : {&null, &emulated})
+    {
+        auto bus = (d == &null) ? std::string{"null"} : "emulator";
+        auto& oled = d->display();
+
+        benchmarks.run("displayUpdate/full/" + bus,
+                       [&](uint64_t i)
+                       {
+                           if (i % 2)
+                           {
+                               oled.fill();
+                           }
+                           else
+                           {
+                               oled.clear();
+                           }
+
+                           oled.displayUpdate();
+                       },
+                       &d->metered());
+
+        benchmarks.run("displayUpdate/pixel/" + bus,
+                       [&](uint64_t i)
+                       {
+                           oled.xorPixel(point(i));
+                           oled.displayUpdate();
+                       },
+                       &d->metered());
+    }
+
+    return EXIT_SUCCESS;
+}
+
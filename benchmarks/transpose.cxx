@@ -0,0 +1,159 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include "OledBitmap.h"
+#include "OledTranspose.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr int Width{128};
+constexpr int Height{64};
+constexpr int Pages{Height / 8};
+constexpr int BytesPerRow{Width / 8};
+constexpr int Frames{20000};
+
+using Clock = std::chrono::steady_clock;
+
+//-------------------------------------------------------------------------
+
+// Convert a whole 128x64 frame, one tile at a time, and return the time
+// taken per tile in nanoseconds.
+
+double
+measure(
+    void (*convert)(uint8_t* rows, uint8_t* page),
+    uint8_t* rows,
+    uint8_t* page)
+{
+    auto start = Clock::now();
+
+    for (auto frame = 0 ; frame < Frames ; ++frame)
+    {
+        convert(rows, page);
+
+        // Feed the result back so that no frame can be skipped.
+
+        rows[frame % (BytesPerRow * Height)] ^= page[frame % (Width * Pages)];
+    }
+
+    std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+    return elapsed.count() / (Frames * BytesPerRow * Pages);
+}
+
+//-------------------------------------------------------------------------
+
+const SSD1306::OledTransposeKernel* kernel = nullptr;
+
+//-------------------------------------------------------------------------
+
+void
+rowsToPages(
+    uint8_t* rows,
+    uint8_t* page)
+{
+    for (auto p = 0 ; p < Pages ; ++p)
+    {
+        for (auto byte = 0 ; byte < BytesPerRow ; ++byte)
+        {
+            kernel->rowsToPage(rows + (p * 8 * BytesPerRow) + byte,
+                               BytesPerRow,
+                               page + (p * Width) + (byte * 8));
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+pagesToRows(
+    uint8_t* rows,
+    uint8_t* page)
+{
+    for (auto p = 0 ; p < Pages ; ++p)
+    {
+        for (auto byte = 0 ; byte < BytesPerRow ; ++byte)
+        {
+            kernel->pageToRows(page + (p * Width) + (byte * 8),
+                               rows + (p * 8 * BytesPerRow) + byte,
+                               BytesPerRow);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+int
+main()
+{
+    std::mt19937 generator;
+
+    uint8_t rows[BytesPerRow * Height];
+    uint8_t page[Width * Pages];
+
+    for (auto& byte : rows)
+    {
+        byte = generator();
+    }
+
+    std::cout << "kernel     rowsToPage  pageToRows  (ns per tile)\n";
+
+    for (auto& k : SSD1306::transposeKernels())
+    {
+        kernel = &k;
+
+        auto toPage = measure(rowsToPages, rows, page);
+        auto toRows = measure(pagesToRows, rows, page);
+
+        std::cout << std::left << std::setw(10) << k.name
+                  << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(11) << toPage
+                  << std::setw(12) << toRows
+                  << "\n";
+    }
+
+    std::cout << "selected: " << SSD1306::transposeKernel().name << "\n";
+
+    return 0;
+}
+
@@ -27,7 +27,6 @@
 
 #include <array>
 #include <chrono>
-#include <cmath>
 #include <csignal>
 #include <cstring>
 #include <exception>
@@ -54,6 +53,7 @@ static constexpr int HourHandLength{18};
 static constexpr int MinuteHandLength{28};
 static constexpr int SecondHandLength{30};
 static constexpr int TickRadius{31};
+static constexpr int HubRadius{2};
 }
 
 //-------------------------------------------------------------------------
@@ -76,18 +76,16 @@ signalHandler(
 
 void
 drawHand(
-    double angle,
+    int angle,
     int length,
     SSD1306::OledPixel& pixels)
 {
-    auto radians = 2.0 * angle * M_PI;
+    SSD1306::OledPoint center{pixels.width() / 2, pixels.height() / 2};
 
-    int xCenter{pixels.width() / 2};
-    int yCenter{pixels.height() / 2};
+    // Angles are measured clockwise from three o'clock.
 
-    SSD1306::line(SSD1306::OledPoint(xCenter, yCenter),
-                  SSD1306::OledPoint(xCenter + int(sin(radians) * length),
-                                     yCenter - int(cos(radians) * length)),
+    SSD1306::line(center,
+                  SSD1306::polarPoint(center, length, angle - 90),
                   SSD1306::PixelStyle::Set,
                   pixels);
 }
@@ -110,26 +108,25 @@ showTime(
 
     //---------------------------------------------------------------------
 
-    auto hour = (tm->tm_hour % 12) / 12.0;
-    auto minute = tm->tm_min / 60.0;
-    auto second = tm->tm_sec / 60.0;
+    auto hour = tm->tm_hour % 12;
+    auto minute = tm->tm_min;
+    auto second = tm->tm_sec;
 
-    drawHand(hour + (minute / 12.0), HourHandLength, pixels);
-    drawHand(minute + (second / 60.0), MinuteHandLength, pixels);
-    drawHand(second, SecondHandLength, pixels);
+    drawHand(((hour * 60) + minute) / 2, HourHandLength, pixels);
+    drawHand(((minute * 60) + second) / 10, MinuteHandLength, pixels);
+    drawHand(second * 6, SecondHandLength, pixels);
 
     //---------------------------------------------------------------------
 
+    SSD1306::OledPoint center{pixels.width() / 2, pixels.height() / 2};
+
     for (auto tick = 0 ; tick < 12 ; ++tick)
     {
-        auto radians = tick * M_PI / 6.0;
-        pixels.setPixel(
-            SSD1306::OledPoint(int(sin(radians) * TickRadius) +
-                               (pixels.width() / 2),
-                               int(cos(radians) * TickRadius) +
-                               (pixels.height() / 2)));
+        pixels.setPixel(SSD1306::polarPoint(center, TickRadius, tick * 30));
     }
 
+    SSD1306::circleFilled(center, HubRadius, SSD1306::PixelStyle::Set, pixels);
+
     //---------------------------------------------------------------------
 }
 
@@ -156,7 +153,7 @@ main()
             }
         }
 
-        SSD1306::OledBitmap<64, 64> bitmap;
+        SSD1306::OledBitmap<64, 64, SSD1306::OledLayout::PageMajor> bitmap;
         SSD1306::OledPoint offset{32, 0};
         SSD1306::OledI2C oled{"/dev/i2c-1", 0x3C};
 
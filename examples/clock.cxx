@@ -87,8 +87,8 @@ showTime(
 
     char time[12];
 
-    auto length = strftime(time, sizeof(time), "%l:%M:%S %P", tm);
-    int offset = (128 - (8 * length)) / 2;
+    strftime(time, sizeof(time), "%l:%M:%S %P", tm);
+    int offset = (oled.width() - SSD1306::measureString8x16(time).width) / 2;
 
     SSD1306::OledPoint location{offset, 18};
 
@@ -98,8 +98,8 @@ showTime(
 
     char date[12];
 
-    length = strftime(date, sizeof(date), "%d %b %Y", tm);
-    offset = (128 - (8 * length)) / 2;
+    strftime(date, sizeof(date), "%d %b %Y", tm);
+    offset = (oled.width() - SSD1306::measureString8x8(date).width) / 2;
 
     location.set(offset, location.y() + 20);
 
@@ -32,13 +32,15 @@
 #include <system_error>
 
 #include "OledBitmap.h"
+#include "OledFramePacer.h"
 #include "OledI2C.h"
 #include "LinuxKeys.h"
 
 //-------------------------------------------------------------------------
 
 using Bitmap = SSD1306::OledBitmap<SSD1306::OledI2C::Width,
-                                   SSD1306::OledI2C::Height>;
+                                   SSD1306::OledI2C::Height,
+                                   SSD1306::OledLayout::PageMajor>;
 
 using Point = SSD1306::OledPoint;
 
@@ -231,6 +233,8 @@ main()
         LinuxKeys linuxKeys;
         LinuxKeys::PressedKey key;
 
+        SSD1306::OledFramePacer pacer{oled, 30};
+
         //-----------------------------------------------------------------
 
         while (run)
@@ -265,7 +269,8 @@ main()
 
             iterateLife(pixels);
             oled.setFrom(pixels);
-            oled.displayUpdate();
+            pacer.update();
+            pacer.wait();
         }
 
         //-----------------------------------------------------------------
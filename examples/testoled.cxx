@@ -26,6 +26,7 @@
 //-------------------------------------------------------------------------
 
 #include "OledFont8x16.h"
+#include "OledFramePacer.h"
 #include "OledI2C.h"
 #include "LinuxKeys.h"
 
@@ -41,7 +42,7 @@ main()
     {
         SSD1306::OledI2C oled{"/dev/i2c-1", 0x3C};
         drawString8x16(SSD1306::OledPoint{32, 24},
-                       "Oled I" "\xFD" "C",
+                       "Oled I²C",
                        SSD1306::PixelStyle::Set,
                        oled);
         oled.displayUpdate();
@@ -59,6 +60,7 @@ main()
         std::uniform_int_distribution<> xDistribution{0, oled.width() - 1};
         std::uniform_int_distribution<> yDistribution{0, oled.height() - 1};
 
+        SSD1306::OledFramePacer pacer{oled, 60};
 
         //-----------------------------------------------------------------
 
@@ -97,7 +99,8 @@ main()
                                  yDistribution(randomGenerator)};
 
             oled.xorPixel(p);
-            oled.displayUpdate();
+            pacer.update();
+            pacer.wait();
         }
 
         oled.clear();
@@ -49,7 +49,11 @@ using OledPoint = Point<int>;
 
 //------------------------------------------------------------------------
 
-template<int WIDTH, int HEIGHT>
+// LAYOUT selects how the pixels are stored. PageMajor matches the
+// display's own memory, so blits between a PageMajor bitmap and the
+// display can copy whole bytes rather than single pixels.
+
+template<int WIDTH, int HEIGHT, OledLayout LAYOUT = OledLayout::RowMajor>
 class OledBitmap
 :
     public OledPixel
@@ -60,7 +64,12 @@ public:
 
     static constexpr int Width{WIDTH};
     static constexpr int Height{HEIGHT};
+    static constexpr OledLayout Layout{LAYOUT};
     static constexpr int BytesPerRow{(WIDTH + 7) / 8};
+    static constexpr int Pages{(HEIGHT + 7) / 8};
+    static constexpr bool IsPageMajor{LAYOUT == OledLayout::PageMajor};
+    static constexpr int Blocks{IsPageMajor ? Pages : Height};
+    static constexpr int BytesPerBlock{IsPageMajor ? Width : BytesPerRow};
 
     OledBitmap()
     :
@@ -68,21 +77,39 @@ public:
     {
     }
 
+    // The list is always row-major, with the leftmost pixel in the most
+    // significant bit, whatever the layout of the bitmap.
+
     OledBitmap(std::initializer_list<int> list)
     :
         blocks_{}
     {
         auto byte = 0;
-        auto block = 0;
+        auto row = 0;
 
         for (auto item : list)
         {
-            blocks_[block][byte++] = item;
+            if (IsPageMajor)
+            {
+                for (auto bit = 0 ; bit < 8 ; ++bit)
+                {
+                    if (item & (0x80 >> bit))
+                    {
+                        setPixel(SSD1306::OledPoint{(byte * 8) + bit, row});
+                    }
+                }
+
+                ++byte;
+            }
+            else
+            {
+                blocks_[row][byte++] = item;
+            }
 
             if ((byte * 8) >= Width)
             {
                 byte = 0;
-                block += 1;
+                row += 1;
             }
         }
     }
@@ -157,15 +184,35 @@ public:
     int width() const override { return Width; }
     int height() const override { return Height; }
 
+    OledRaster
+    raster() override
+    {
+        return OledRaster{Layout,
+                          Width,
+                          Height,
+                          BytesPerBlock,
+                          blocks_.front().data()};
+    }
+
+    OledConstRaster
+    raster() const override
+    {
+        return OledConstRaster{Layout,
+                               Width,
+                               Height,
+                               BytesPerBlock,
+                               blocks_.front().data()};
+    }
+
 private:
 
     struct PixelOffset
     {
         PixelOffset(SSD1306::OledPoint p)
         :
-            bit{7 - (p.x() % 8)},
-            block{p.y()},
-            byte{p.x() / 8}
+            bit{IsPageMajor ? (p.y() % 8) : (7 - (p.x() % 8))},
+            block{IsPageMajor ? (p.y() / 8) : p.y()},
+            byte{IsPageMajor ? p.x() : (p.x() / 8)}
         {
         }
 
@@ -182,7 +229,7 @@ private:
         }
     }
 
-    std::array<std::array<uint8_t, BytesPerRow>, Height> blocks_;
+    std::array<std::array<uint8_t, BytesPerBlock>, Blocks> blocks_;
 };
 
 //------------------------------------------------------------------------
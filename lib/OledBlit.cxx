@@ -0,0 +1,862 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "OledBlit.h"
+#include "OledTranspose.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// The widest word that the processor handles natively: 64 bits on 64 bit
+// systems and 32 bits on the 32 bit ARM cores of the smaller boards.
+
+using Word = std::conditional<(sizeof(void*) >= 8), uint64_t, uint32_t>::type;
+
+constexpr int WordBytes{sizeof(Word)};
+
+//-------------------------------------------------------------------------
+
+struct Area
+{
+    int xStart;
+    int xEnd;
+    int yStart;
+    int yEnd;
+};
+
+//-------------------------------------------------------------------------
+
+int
+floorDiv8(
+    int value)
+{
+    return (value >= 0) ? (value / 8) : -((7 - value) / 8);
+}
+
+//-------------------------------------------------------------------------
+
+template<typename WORD>
+constexpr WORD
+repeat(
+    uint8_t byte)
+{
+    return static_cast<WORD>((static_cast<WORD>(~WORD{0}) / 0xFF) * byte);
+}
+
+//-------------------------------------------------------------------------
+
+// OP is a template parameter, so that the switch is resolved when the
+// blit is compiled rather than for every word.
+
+template<SSD1306::RasterOp OP, typename WORD>
+WORD
+combine(
+    WORD destination,
+    WORD source,
+    WORD mask)
+{
+    WORD result = source;
+
+    switch (OP)
+    {
+    case SSD1306::RasterOp::Copy:
+
+        break;
+
+    case SSD1306::RasterOp::Set:
+
+        result = destination | source;
+        break;
+
+    case SSD1306::RasterOp::Unset:
+
+        result = destination & ~source;
+        break;
+
+    case SSD1306::RasterOp::Xor:
+
+        result = destination ^ source;
+        break;
+    }
+
+    return static_cast<WORD>((destination & ~mask) | (result & mask));
+}
+
+//-------------------------------------------------------------------------
+
+// Each destination byte is eight rows of one column, built from the
+// bottom of one source byte (upper) and the top of the next (lower).
+// Bytes are independent, so a word of them can be shifted at once as
+// long as the bits that cross from one byte to the next are masked off.
+// Column x of row comes from column sourceX of upper and lower.
+
+template<SSD1306::RasterOp OP, typename WORD>
+void
+mergeColumns(
+    const uint8_t* upper,
+    const uint8_t* lower,
+    int shift,
+    uint8_t mask,
+    uint8_t* row,
+    int x,
+    int sourceX,
+    int& first,
+    int& last)
+{
+    WORD value{0};
+    WORD bytes;
+
+    if (upper)
+    {
+        std::memcpy(&bytes, upper + sourceX, sizeof(WORD));
+        value = (bytes >> shift) & repeat<WORD>(0xFF >> shift);
+    }
+
+    if (lower)
+    {
+        std::memcpy(&bytes, lower + sourceX, sizeof(WORD));
+        value |= (bytes << (8 - shift))
+               & repeat<WORD>(static_cast<uint8_t>(0xFF << (8 - shift)));
+    }
+
+    WORD before;
+    std::memcpy(&before, row + x, sizeof(WORD));
+
+    WORD after = combine<OP, WORD>(before, value, repeat<WORD>(mask));
+
+    if (after != before)
+    {
+        std::memcpy(row + x, &after, sizeof(WORD));
+
+        uint8_t beforeBytes[sizeof(WORD)];
+        uint8_t afterBytes[sizeof(WORD)];
+
+        std::memcpy(beforeBytes, &before, sizeof(WORD));
+        std::memcpy(afterBytes, &after, sizeof(WORD));
+
+        for (auto i = 0 ; i < static_cast<int>(sizeof(WORD)) ; ++i)
+        {
+            if (beforeBytes[i] != afterBytes[i])
+            {
+                first = std::min(first, x + i);
+                last = std::max(last, x + i);
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+template<SSD1306::RasterOp OP>
+void
+blitPages(
+    const SSD1306::OledConstRaster& source,
+    const SSD1306::OledRaster& destination,
+    const SSD1306::OledPoint& offset,
+    const Area& area,
+    SSD1306::OledPixel& pixels)
+{
+    auto sourcePages = (source.height + 7) / 8;
+
+    for (auto page = area.yStart / 8 ; (page * 8) < area.yEnd ; ++page)
+    {
+        auto top = std::max(area.yStart, page * 8);
+        auto bottom = std::min(area.yEnd, (page + 1) * 8);
+
+        uint8_t mask = ((1 << (bottom - top)) - 1) << (top - (page * 8));
+
+        auto sourceRow = (page * 8) - offset.y();
+        auto sourcePage = floorDiv8(sourceRow);
+        auto shift = sourceRow - (sourcePage * 8);
+
+        const uint8_t* upper = nullptr;
+        const uint8_t* lower = nullptr;
+
+        if ((sourcePage >= 0) && (sourcePage < sourcePages))
+        {
+            upper = source.bytes + (sourcePage * source.stride);
+        }
+
+        if ((shift != 0) &&
+            ((sourcePage + 1) >= 0) &&
+            ((sourcePage + 1) < sourcePages))
+        {
+            lower = source.bytes + ((sourcePage + 1) * source.stride);
+        }
+
+        auto row = destination.bytes + (page * destination.stride);
+        auto first = area.xEnd;
+        auto last = area.xStart - 1;
+        auto x = area.xStart;
+
+        for ( ; (x + WordBytes) <= area.xEnd ; x += WordBytes)
+        {
+            mergeColumns<OP, Word>(upper,
+                                   lower,
+                                   shift,
+                                   mask,
+                                   row,
+                                   x,
+                                   x - offset.x(),
+                                   first,
+                                   last);
+        }
+
+        for ( ; x < area.xEnd ; ++x)
+        {
+            mergeColumns<OP, uint8_t>(upper,
+                                      lower,
+                                      shift,
+                                      mask,
+                                      row,
+                                      x,
+                                      x - offset.x(),
+                                      first,
+                                      last);
+        }
+
+        if (first <= last)
+        {
+            pixels.rasterChanged(SSD1306::OledPoint{first, top},
+                                 SSD1306::OledPoint{last, bottom - 1});
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+uint8_t
+byteAt(
+    const uint8_t* row,
+    int rowBytes,
+    int index)
+{
+    return ((index >= 0) && (index < rowBytes)) ? row[index] : 0;
+}
+
+//-------------------------------------------------------------------------
+
+// Read sizeof(WORD) * 8 pixels of a row-major row starting at pixel bit,
+// leftmost pixel in the most significant bit. Pixels outside the row
+// read as unset.
+
+template<typename WORD>
+WORD
+loadBits(
+    const uint8_t* row,
+    int rowBytes,
+    int bit)
+{
+    constexpr int bytes = sizeof(WORD);
+
+    auto index = floorDiv8(bit);
+    auto shift = bit - (index * 8);
+    WORD value{0};
+
+    if ((index >= 0) && ((index + bytes) < rowBytes))
+    {
+        for (auto i = 0 ; i < bytes ; ++i)
+        {
+            value = static_cast<WORD>((value << 8) | row[index + i]);
+        }
+
+        if (shift != 0)
+        {
+            value = static_cast<WORD>((value << shift) |
+                                      (row[index + bytes] >> (8 - shift)));
+        }
+    }
+    else
+    {
+        for (auto i = 0 ; i < bytes ; ++i)
+        {
+            value = static_cast<WORD>((value << 8) |
+                                      byteAt(row, rowBytes, index + i));
+        }
+
+        if (shift != 0)
+        {
+            auto next = byteAt(row, rowBytes, index + bytes);
+            value = static_cast<WORD>((value << shift) |
+                                      (next >> (8 - shift)));
+        }
+    }
+
+    return value;
+}
+
+//-------------------------------------------------------------------------
+
+template<SSD1306::RasterOp OP, typename WORD>
+bool
+mergeBits(
+    const uint8_t* sourceRow,
+    int sourceBytes,
+    int sourceBit,
+    WORD mask,
+    uint8_t* row)
+{
+    constexpr int bytes = sizeof(WORD);
+
+    WORD value = loadBits<WORD>(sourceRow, sourceBytes, sourceBit);
+    WORD before{0};
+
+    for (auto i = 0 ; i < bytes ; ++i)
+    {
+        before = static_cast<WORD>((before << 8) | row[i]);
+    }
+
+    WORD after = combine<OP, WORD>(before, value, mask);
+
+    if (after == before)
+    {
+        return false;
+    }
+
+    for (auto i = bytes - 1 ; i >= 0 ; --i)
+    {
+        row[i] = static_cast<uint8_t>(after);
+        after = static_cast<WORD>(after >> 8);
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+template<SSD1306::RasterOp OP>
+void
+blitRows(
+    const SSD1306::OledConstRaster& source,
+    const SSD1306::OledRaster& destination,
+    const SSD1306::OledPoint& offset,
+    const Area& area,
+    SSD1306::OledPixel& pixels)
+{
+    auto sourceBytes = (source.width + 7) / 8;
+    auto firstByte = area.xStart / 8;
+    auto lastByte = (area.xEnd - 1) / 8;
+
+    auto first = area.xEnd;
+    auto last = area.xStart - 1;
+    auto top = area.yEnd;
+    auto bottom = area.yStart - 1;
+
+    for (auto y = area.yStart ; y < area.yEnd ; ++y)
+    {
+        auto sourceRow = source.bytes + ((y - offset.y()) * source.stride);
+        auto row = destination.bytes + (y * destination.stride);
+        auto changed = false;
+        auto byte = firstByte;
+
+        while (byte <= lastByte)
+        {
+            auto left = std::max(area.xStart, byte * 8) - (byte * 8);
+            auto right = std::min(area.xEnd, (byte + 1) * 8) - (byte * 8);
+            auto sourceBit = (byte * 8) - offset.x();
+
+            if ((left == 0) && ((byte + WordBytes) <= lastByte))
+            {
+                if (mergeBits<OP, Word>(sourceRow,
+                                        sourceBytes,
+                                        sourceBit,
+                                        static_cast<Word>(~Word{0}),
+                                        row + byte))
+                {
+                    first = std::min(first, byte * 8);
+                    last = std::max(last, ((byte + WordBytes) * 8) - 1);
+                    changed = true;
+                }
+
+                byte += WordBytes;
+            }
+            else
+            {
+                uint8_t mask = (0xFF >> left) & (0xFF << (8 - right));
+
+                if (mergeBits<OP, uint8_t>(sourceRow,
+                                           sourceBytes,
+                                           sourceBit,
+                                           mask,
+                                           row + byte))
+                {
+                    first = std::min(first, byte * 8);
+                    last = std::max(last, (byte * 8) + 7);
+                    changed = true;
+                }
+
+                ++byte;
+            }
+        }
+
+        if (changed)
+        {
+            top = std::min(top, y);
+            bottom = y;
+        }
+    }
+
+    if (top <= bottom)
+    {
+        first = std::max(first, area.xStart);
+        last = std::min(last, area.xEnd - 1);
+
+        pixels.rasterChanged(SSD1306::OledPoint{first, top},
+                             SSD1306::OledPoint{last, bottom});
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// Between layouts the blit goes a tile of 8x8 pixels at a time. The
+// source pixels of each tile are gathered into the source's byte order
+// and then transposed into the destination's.
+
+template<SSD1306::RasterOp OP>
+void
+rowsToPages(
+    const SSD1306::OledConstRaster& source,
+    const SSD1306::OledRaster& destination,
+    const SSD1306::OledPoint& offset,
+    const Area& area,
+    SSD1306::OledPixel& pixels)
+{
+    auto& kernel = SSD1306::transposeKernel();
+    auto sourceBytes = (source.width + 7) / 8;
+
+    for (auto page = area.yStart / 8 ; (page * 8) < area.yEnd ; ++page)
+    {
+        auto top = std::max(area.yStart, page * 8);
+        auto bottom = std::min(area.yEnd, (page + 1) * 8);
+
+        uint8_t mask = ((1 << (bottom - top)) - 1) << (top - (page * 8));
+
+        auto row = destination.bytes + (page * destination.stride);
+        auto first = area.xEnd;
+        auto last = area.xStart - 1;
+
+        for (auto x = area.xStart ; x < area.xEnd ; x += 8)
+        {
+            uint8_t rows[8];
+
+            for (auto i = 0 ; i < 8 ; ++i)
+            {
+                auto y = (page * 8) + i - offset.y();
+
+                if ((y >= 0) && (y < source.height))
+                {
+                    rows[i] = loadBits<uint8_t>(source.bytes
+                                                + (y * source.stride),
+                                                sourceBytes,
+                                                x - offset.x());
+                }
+                else
+                {
+                    rows[i] = 0;
+                }
+            }
+
+            uint8_t columns[8];
+            kernel.rowsToPage(rows, 1, columns);
+
+            auto count = std::min(8, area.xEnd - x);
+
+            for (auto i = 0 ; i < count ; ++i)
+            {
+                auto byte = combine<OP, uint8_t>(row[x + i],
+                                                 columns[i],
+                                                 mask);
+
+                if (byte != row[x + i])
+                {
+                    row[x + i] = byte;
+                    first = std::min(first, x + i);
+                    last = x + i;
+                }
+            }
+        }
+
+        if (first <= last)
+        {
+            pixels.rasterChanged(SSD1306::OledPoint{first, top},
+                                 SSD1306::OledPoint{last, bottom - 1});
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+template<SSD1306::RasterOp OP>
+void
+pagesToRows(
+    const SSD1306::OledConstRaster& source,
+    const SSD1306::OledRaster& destination,
+    const SSD1306::OledPoint& offset,
+    const Area& area,
+    SSD1306::OledPixel& pixels)
+{
+    auto& kernel = SSD1306::transposeKernel();
+    auto sourcePages = (source.height + 7) / 8;
+
+    auto first = area.xEnd;
+    auto last = area.xStart - 1;
+    auto top = area.yEnd;
+    auto bottom = area.yStart - 1;
+
+    for (auto y = area.yStart ; y < area.yEnd ; y += 8)
+    {
+        auto sourceRow = y - offset.y();
+        auto sourcePage = floorDiv8(sourceRow);
+        auto shift = sourceRow - (sourcePage * 8);
+        auto count = std::min(8, area.yEnd - y);
+
+        const uint8_t* upper = nullptr;
+        const uint8_t* lower = nullptr;
+
+        if ((sourcePage >= 0) && (sourcePage < sourcePages))
+        {
+            upper = source.bytes + (sourcePage * source.stride);
+        }
+
+        if ((shift != 0) &&
+            ((sourcePage + 1) >= 0) &&
+            ((sourcePage + 1) < sourcePages))
+        {
+            lower = source.bytes + ((sourcePage + 1) * source.stride);
+        }
+
+        for (auto byte = area.xStart / 8 ; (byte * 8) < area.xEnd ; ++byte)
+        {
+            auto left = std::max(area.xStart, byte * 8) - (byte * 8);
+            auto right = std::min(area.xEnd, (byte + 1) * 8) - (byte * 8);
+
+            uint8_t mask = (0xFF >> left) & (0xFF << (8 - right));
+            uint8_t columns[8] = {};
+
+            for (auto i = left ; i < right ; ++i)
+            {
+                auto x = (byte * 8) + i;
+
+                if (upper)
+                {
+                    columns[i] = upper[x - offset.x()] >> shift;
+                }
+
+                if (lower)
+                {
+                    columns[i] |= lower[x - offset.x()] << (8 - shift);
+                }
+            }
+
+            uint8_t rows[8];
+            kernel.pageToRows(columns, rows, 1);
+
+            for (auto i = 0 ; i < count ; ++i)
+            {
+                auto& target = destination.bytes[((y + i) * destination.stride)
+                                                 + byte];
+                auto result = combine<OP, uint8_t>(target, rows[i], mask);
+
+                if (result != target)
+                {
+                    target = result;
+                    first = std::min(first, (byte * 8) + left);
+                    last = std::max(last, (byte * 8) + right - 1);
+                    top = std::min(top, y + i);
+                    bottom = std::max(bottom, y + i);
+                }
+            }
+        }
+    }
+
+    if (top <= bottom)
+    {
+        pixels.rasterChanged(SSD1306::OledPoint{first, top},
+                             SSD1306::OledPoint{last, bottom});
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+isSetRaster(
+    const SSD1306::OledConstRaster& raster,
+    const SSD1306::OledPoint& p)
+{
+    if (raster.layout == SSD1306::OledLayout::PageMajor)
+    {
+        return raster.bytes[((p.y() / 8) * raster.stride) + p.x()]
+             & (1 << (p.y() % 8));
+    }
+
+    return raster.bytes[(p.y() * raster.stride) + (p.x() / 8)]
+         & (0x80 >> (p.x() % 8));
+}
+
+//-------------------------------------------------------------------------
+
+Area
+clip(
+    int width,
+    int height,
+    const SSD1306::OledPoint& offset,
+    const SSD1306::OledPixel& pixels)
+{
+    return Area{std::max(0, offset.x()),
+                std::min(pixels.width(), width + offset.x()),
+                std::max(0, offset.y()),
+                std::min(pixels.height(), height + offset.y())};
+}
+
+//-------------------------------------------------------------------------
+
+bool
+empty(
+    const Area& area)
+{
+    return (area.xStart >= area.xEnd) || (area.yStart >= area.yEnd);
+}
+
+//-------------------------------------------------------------------------
+
+template<SSD1306::RasterOp OP, typename IS_SET>
+void
+blitPixels(
+    IS_SET isSet,
+    const SSD1306::OledPoint& offset,
+    const Area& area,
+    SSD1306::OledPixel& pixels)
+{
+    for (auto y = area.yStart ; y < area.yEnd ; ++y)
+    {
+        for (auto x = area.xStart ; x < area.xEnd ; ++x)
+        {
+            SSD1306::OledPoint inputP{x - offset.x(), y - offset.y()};
+            SSD1306::OledPoint outputP{x, y};
+
+            auto set = isSet(inputP);
+
+            switch (OP)
+            {
+            case SSD1306::RasterOp::Copy:
+
+                if (set)
+                {
+                    pixels.setPixel(outputP);
+                }
+                else
+                {
+                    pixels.unsetPixel(outputP);
+                }
+
+                break;
+
+            case SSD1306::RasterOp::Set:
+
+                if (set)
+                {
+                    pixels.setPixel(outputP);
+                }
+
+                break;
+
+            case SSD1306::RasterOp::Unset:
+
+                if (set)
+                {
+                    pixels.unsetPixel(outputP);
+                }
+
+                break;
+
+            case SSD1306::RasterOp::Xor:
+
+                if (set)
+                {
+                    pixels.xorPixel(outputP);
+                }
+
+                break;
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// Call blit() with the raster op as a std::integral_constant, choosing
+// the instantiation of the blit once rather than for every byte.
+
+template<typename BLIT>
+void
+dispatchOp(
+    SSD1306::RasterOp op,
+    BLIT blit)
+{
+    switch (op)
+    {
+    case SSD1306::RasterOp::Copy:
+
+        blit(std::integral_constant<SSD1306::RasterOp,
+                                    SSD1306::RasterOp::Copy>{});
+        break;
+
+    case SSD1306::RasterOp::Set:
+
+        blit(std::integral_constant<SSD1306::RasterOp,
+                                    SSD1306::RasterOp::Set>{});
+        break;
+
+    case SSD1306::RasterOp::Unset:
+
+        blit(std::integral_constant<SSD1306::RasterOp,
+                                    SSD1306::RasterOp::Unset>{});
+        break;
+
+    case SSD1306::RasterOp::Xor:
+
+        blit(std::integral_constant<SSD1306::RasterOp,
+                                    SSD1306::RasterOp::Xor>{});
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+template<SSD1306::RasterOp OP>
+void
+blitRaster(
+    const SSD1306::OledConstRaster& source,
+    const SSD1306::OledPoint& offset,
+    const Area& area,
+    SSD1306::OledPixel& pixels)
+{
+    auto destination = pixels.raster();
+
+    if (destination.bytes == nullptr)
+    {
+        blitPixels<OP>([&source](const SSD1306::OledPoint& p)
+                       {
+                           return isSetRaster(source, p);
+                       },
+                       offset,
+                       area,
+                       pixels);
+    }
+    else if (source.layout != destination.layout)
+    {
+        if (destination.layout == SSD1306::OledLayout::PageMajor)
+        {
+            rowsToPages<OP>(source, destination, offset, area, pixels);
+        }
+        else
+        {
+            pagesToRows<OP>(source, destination, offset, area, pixels);
+        }
+    }
+    else if (source.layout == SSD1306::OledLayout::PageMajor)
+    {
+        blitPages<OP>(source, destination, offset, area, pixels);
+    }
+    else
+    {
+        blitRows<OP>(source, destination, offset, area, pixels);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::blit(
+    const OledConstRaster& source,
+    const OledPoint& offset,
+    RasterOp op,
+    OledPixel& pixels)
+{
+    auto area = clip(source.width, source.height, offset, pixels);
+
+    if (empty(area))
+    {
+        return;
+    }
+
+    dispatchOp(op, [&](auto o)
+    {
+        blitRaster<decltype(o)::value>(source, offset, area, pixels);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::blit(
+    const OledPixel& source,
+    const OledPoint& offset,
+    RasterOp op,
+    OledPixel& pixels)
+{
+    auto raster = source.raster();
+
+    if (raster.bytes != nullptr)
+    {
+        blit(raster, offset, op, pixels);
+        return;
+    }
+
+    auto area = clip(source.width(), source.height(), offset, pixels);
+
+    if (empty(area))
+    {
+        return;
+    }
+
+    dispatchOp(op, [&](auto o)
+    {
+        blitPixels<decltype(o)::value>([&source](const OledPoint& p)
+                                       {
+                                           return source.isSetPixel(p);
+                                       },
+                                       offset,
+                                       area,
+                                       pixels);
+    });
+}
+
@@ -0,0 +1,88 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_BLIT_H
+#define OLED_BLIT_H
+
+//-------------------------------------------------------------------------
+
+#include "OledPixel.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// How each source pixel is combined with the pixel it lands on.
+//
+// Copy - the destination pixel takes the value of the source pixel.
+// Set - set source pixels are set in the destination.
+// Unset - set source pixels are unset in the destination.
+// Xor - set source pixels are inverted in the destination.
+
+enum class RasterOp
+{
+    Copy,
+    Set,
+    Unset,
+    Xor
+};
+
+//-------------------------------------------------------------------------
+
+// Draw source into pixels with its top left corner at offset. The source
+// may also be a raster view of bytes held elsewhere, such as a glyph in
+// a font table. When both sides have bytes, whole bytes or words are
+// combined at a time and the changed area is reported through
+// rasterChanged(). Otherwise each pixel goes through isSetPixel() and
+// setPixel() / unsetPixel() / xorPixel().
+
+void
+blit(
+    const OledConstRaster& source,
+    const OledPoint& offset,
+    RasterOp op,
+    OledPixel& pixels);
+
+void
+blit(
+    const OledPixel& source,
+    const OledPoint& offset,
+    RasterOp op,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,139 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <stdexcept>
+
+#include "OledBusModel.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+    // The address and control bytes that lead each I2C message, and the
+    // start and stop conditions around it.
+
+    constexpr int I2C_MESSAGE_BYTES{2};
+    constexpr int I2C_MESSAGE_CONDITIONS{2};
+
+    // Eight data bits and an ACK.
+
+    constexpr int I2C_BITS_PER_BYTE{9};
+    constexpr int SPI_BITS_PER_BYTE{8};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledBusModel::OledBusModel(
+    Bus bus,
+    uint32_t clock)
+:
+    bus_{bus},
+    clock_{clock}
+{
+    if (clock == 0)
+    {
+        throw std::invalid_argument("bus clock must be greater than zero");
+    }
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledBusModel
+SSD1306::OledBusModel::i2c(
+    uint32_t clock)
+{
+    return OledBusModel{Bus::I2C, clock};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledBusModel
+SSD1306::OledBusModel::spi(
+    uint32_t clock)
+{
+    return OledBusModel{Bus::SPI, clock};
+}
+
+//------------------------------------------------------------------------
+
+uint64_t
+SSD1306::OledBusModel::wireBytes(
+    const OledTransaction& transaction) const
+{
+    uint64_t bytes = transaction.size();
+
+    switch (bus_)
+    {
+    case Bus::I2C:
+
+        bytes += transaction.segments().size() * I2C_MESSAGE_BYTES;
+        break;
+
+    case Bus::SPI:
+
+        break;
+    }
+
+    return bytes;
+}
+
+//------------------------------------------------------------------------
+
+uint64_t
+SSD1306::OledBusModel::bitTimes(
+    const OledTransaction& transaction) const
+{
+    uint64_t bits{0};
+
+    switch (bus_)
+    {
+    case Bus::I2C:
+
+        bits = (wireBytes(transaction) * I2C_BITS_PER_BYTE) +
+               (transaction.segments().size() * I2C_MESSAGE_CONDITIONS);
+        break;
+
+    case Bus::SPI:
+
+        bits = wireBytes(transaction) * SPI_BITS_PER_BYTE;
+        break;
+    }
+
+    return bits;
+}
+
+//------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+SSD1306::OledBusModel::time(
+    const OledTransaction& transaction) const
+{
+    return std::chrono::nanoseconds{(bitTimes(transaction) * 1000000000) /
+                                    clock_};
+}
+
@@ -0,0 +1,102 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_BUS_MODEL_H
+#define OLED_BUS_MODEL_H
+
+//------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+
+#include "OledTransaction.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// An estimate of how long a transaction keeps the bus busy, for
+// budgeting display traffic on a bus shared with other devices.
+//
+// On I2C each segment of a transaction is one message: a start
+// condition, the address byte, the control byte and then the segment,
+// with every byte followed by an ACK bit, and a stop condition. Start
+// and stop are each counted as one bit time, which is close to the
+// set-up and hold times the I2C specification gives at every clock.
+//
+// On SPI each byte is eight clocks. The D/C line is driven outside the
+// clock, and chip select and inter-transfer gaps are not counted.
+
+class OledBusModel
+{
+public:
+
+    enum class Bus
+    {
+        I2C,
+        SPI
+    };
+
+    static constexpr uint32_t I2CStandardMode{100000};
+    static constexpr uint32_t I2CFastMode{400000};
+    static constexpr uint32_t I2CFastModePlus{1000000};
+
+    OledBusModel(Bus bus, uint32_t clock);
+
+    static OledBusModel i2c(uint32_t clock = I2CFastMode);
+    static OledBusModel spi(uint32_t clock);
+
+    Bus bus() const { return bus_; }
+    uint32_t clock() const { return clock_; }
+
+    // Bytes on the wire, including the I2C address and control bytes.
+
+    uint64_t wireBytes(const OledTransaction& transaction) const;
+
+    // Bit times on the wire, including start, stop and ACK on I2C.
+
+    uint64_t bitTimes(const OledTransaction& transaction) const;
+
+    std::chrono::nanoseconds time(const OledTransaction& transaction) const;
+
+private:
+
+    Bus bus_;
+    uint32_t clock_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,107 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <stdexcept>
+
+#include "OledCommandBatch.h"
+
+//------------------------------------------------------------------------
+
+SSD1306::OledCommandBatch::OledCommandBatch()
+:
+    bytes_{},
+    size_{0}
+{
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledCommandBatch::OledCommandBatch(
+    std::initializer_list<uint8_t> commands)
+:
+    bytes_{},
+    size_{0}
+{
+    reserve(commands.size());
+
+    for (auto command : commands)
+    {
+        bytes_[size_++] = command;
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledCommandBatch::add(
+    uint8_t command)
+{
+    reserve(1);
+
+    bytes_[size_++] = command;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledCommandBatch::add(
+    uint8_t command,
+    uint8_t value)
+{
+    reserve(2);
+
+    bytes_[size_++] = command;
+    bytes_[size_++] = value;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledCommandBatch::add(
+    uint8_t command,
+    uint8_t v1,
+    uint8_t v2)
+{
+    reserve(3);
+
+    bytes_[size_++] = command;
+    bytes_[size_++] = v1;
+    bytes_[size_++] = v2;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledCommandBatch::reserve(
+    int length)
+{
+    if ((size_ + length) > Capacity)
+    {
+        throw std::length_error("OledCommandBatch capacity exceeded");
+    }
+}
+
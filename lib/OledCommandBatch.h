@@ -0,0 +1,80 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_COMMAND_BATCH_H
+#define OLED_COMMAND_BATCH_H
+
+//------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// Collects SSD1306 command bytes so that they can be sent to the
+// controller as a single transfer.
+
+class OledCommandBatch
+{
+public:
+
+    static constexpr int Capacity{32};
+
+    OledCommandBatch();
+    OledCommandBatch(std::initializer_list<uint8_t> commands);
+
+    void add(uint8_t command);
+    void add(uint8_t command, uint8_t value);
+    void add(uint8_t command, uint8_t v1, uint8_t v2);
+
+    void clear() { size_ = 0; }
+    bool empty() const { return size_ == 0; }
+
+    const uint8_t* data() const { return bytes_.data(); }
+    int size() const { return size_; }
+
+private:
+
+    void reserve(int length);
+
+    std::array<uint8_t, Capacity> bytes_;
+    int size_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
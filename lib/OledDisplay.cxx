@@ -0,0 +1,720 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "OledDisplay.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+    // address modes
+
+    constexpr uint8_t OLED_HORIZONTAL_ADDRESSING_MODE{0x00};
+    constexpr uint8_t OLED_VERTICAL_ADDRESSING_MODE{0x01};
+    constexpr uint8_t OLED_PAGE_ADDRESSING_MODE{0x02};
+
+    // commands
+
+    constexpr uint8_t OLED_SET_COLUMN_START_LOW_MASK{0x00};
+    constexpr uint8_t OLED_SET_COLUMN_START_HIGH_MASK{0x10};
+    constexpr uint8_t OLED_SET_MEMORY_ADDRESSING_MODE{0x20};
+    constexpr uint8_t OLED_SET_COLUMN_ADDRESS{0x21};
+    constexpr uint8_t OLED_SET_PAGE_ADDRESS{0x22};
+    constexpr uint8_t OLED_SET_DISPLAY_START_LINE_MASK{0x40};
+    constexpr uint8_t OLED_SET_CONTRAST{0x81};
+    constexpr uint8_t OLED_ENABLE_CHARGE_PUMP_REGULATOR{0x8D};
+    constexpr uint8_t OLED_SET_SEGMENT_REMAP_0{0xA0};
+    constexpr uint8_t OLED_SET_SEGMENT_REMAP_127{0xA1};
+    constexpr uint8_t OLED_SET_ENTIRE_DISPLAY_ON_RESUME{0xA4};
+    constexpr uint8_t OLED_SET_ENTIRE_DISPLAY_ON_FORCE{0xA5};
+    constexpr uint8_t OLED_SET_NORMAL_DISPLAY{0xA6};
+    constexpr uint8_t OLED_SET_INVERSE_DISPLAY{0xA7};
+    constexpr uint8_t OLED_SET_MUX_RATIO{0xA8};
+    constexpr uint8_t OLED_SET_DISPLAY_OFF{0xAE};
+    constexpr uint8_t OLED_SET_DISPLAY_ON{0xAF};
+    constexpr uint8_t OLED_SET_PAGE_START_ADDRESS_MASK{0xB0};
+    constexpr uint8_t OLED_SET_COM_OUTPUT_SCAN_DIRECTION_NORMAL{0xC0};
+    constexpr uint8_t OLED_SET_COM_OUTPUT_SCAN_DIRECTION_REMAP{0xC8};
+    constexpr uint8_t OLED_SET_DISPLAY_OFFSET{0xD3};
+    constexpr uint8_t OLED_SET_OSC_FREQUENCY{0xD5};
+    constexpr uint8_t OLED_SET_PRECHARGE_PERIOD{0xD9};
+    constexpr uint8_t OLED_SET_COM_PINS_HARDWARE_CONFIGURATION{0xDA};
+    constexpr uint8_t OLED_SET_VCOMH_DESELECT_LEVEL{0xDB};
+
+    //--------------------------------------------------------------------
+
+    struct PixelOffset
+    {
+        PixelOffset(SSD1306::OledPoint p)
+        :
+            bit{p.y() % 8},
+            page{p.y() / 8},
+            column{p.x()},
+            byte{p.x() + (SSD1306::OledDisplay::Width * (p.y() / 8))}
+        {
+        }
+
+        int bit;
+        int page;
+        int column;
+        int byte;
+    };
+
+    //--------------------------------------------------------------------
+
+    constexpr int FrameCost{SSD1306::OledDisplay::WindowOverhead
+                            + SSD1306::OledDisplay::FrameSize};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledDisplay::OledDisplay(
+    std::unique_ptr<OledTransport> transport)
+:
+    transport_{std::move(transport)},
+    sendMutex_{},
+    frame_{},
+    dirty_{},
+    front_{},
+    frontDirty_{},
+    pending_{false},
+    busy_{false},
+    stop_{false},
+    error_{},
+    flushMutex_{},
+    flushCondition_{},
+    flusher_{}
+{
+    clean(frontDirty_);
+
+    for (auto page = 0 ; page < Pages ; ++page)
+    {
+        markDirty(page, 0, Width - 1);
+    }
+
+    init();
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledDisplay::~OledDisplay()
+{
+    if (flusher_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock{flushMutex_};
+            stop_ = true;
+        }
+
+        flushCondition_.notify_all();
+        flusher_.join();
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::clear()
+{
+    fillWith(0x00);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::fill()
+{
+    fillWith(0xFF);
+}
+
+//------------------------------------------------------------------------
+
+bool
+SSD1306::OledDisplay::isSetPixel(
+    SSD1306::OledPoint p) const
+{
+    if (not pixelInside(p))
+    {
+        return false;
+    }
+
+    PixelOffset po{p};
+
+    return frame_[po.byte] & (1 << po.bit);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::setPixel(
+    SSD1306::OledPoint p)
+{
+    if (not pixelInside(p))
+    {
+        return;
+    }
+
+    PixelOffset po{p};
+
+    if ((frame_[po.byte] & (1 << po.bit)) == 0)
+    {
+        frame_[po.byte] |= (1 << po.bit);
+        markDirty(po.page, po.column, po.column);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::unsetPixel(
+    SSD1306::OledPoint p)
+{
+    if (not pixelInside(p))
+    {
+        return;
+    }
+
+    PixelOffset po{p};
+
+    if ((frame_[po.byte] & (1 << po.bit)) != 0)
+    {
+        frame_[po.byte] &= ~(1 << po.bit);
+        markDirty(po.page, po.column, po.column);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::xorPixel(
+    SSD1306::OledPoint p)
+{
+    if (not pixelInside(p))
+    {
+        return;
+    }
+
+    PixelOffset po{p};
+
+    frame_[po.byte] ^= (1 << po.bit);
+    markDirty(po.page, po.column, po.column);
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledBitmap<SSD1306::OledDisplay::Width, SSD1306::OledDisplay::Height>
+SSD1306::OledDisplay::getBitmap() const
+{
+    OledBitmap<Width, Height> bitmap;
+    bitmap.setFrom(*this);
+
+    return bitmap;
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledRaster
+SSD1306::OledDisplay::raster()
+{
+    return OledRaster{OledLayout::PageMajor,
+                      Width,
+                      Height,
+                      Width,
+                      frame_.data()};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledConstRaster
+SSD1306::OledDisplay::raster() const
+{
+    return OledConstRaster{OledLayout::PageMajor,
+                           Width,
+                           Height,
+                           Width,
+                           frame_.data()};
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::rasterChanged(
+    SSD1306::OledPoint p1,
+    SSD1306::OledPoint p2)
+{
+    auto first = std::max(0, p1.x());
+    auto last = std::min(Width - 1, p2.x());
+
+    if (first > last)
+    {
+        return;
+    }
+
+    auto firstPage = std::max(0, p1.y() / 8);
+    auto lastPage = std::min(Pages - 1, p2.y() / 8);
+
+    for (auto page = firstPage ; page <= lastPage ; ++page)
+    {
+        markDirty(page, first, last);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::displayInverse() const
+{
+    sendCommands({OLED_SET_INVERSE_DISPLAY});
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::displayNormal() const
+{
+    sendCommands({OLED_SET_NORMAL_DISPLAY});
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::displayOff() const
+{
+    sendCommands({OLED_SET_DISPLAY_OFF});
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::displayOn() const
+{
+    sendCommands({OLED_SET_DISPLAY_ON});
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::displaySetContrast(
+    uint8_t contrast) const
+{
+    sendCommands({OLED_SET_CONTRAST, contrast});
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::displayUpdate()
+{
+    if (flusher_.joinable())
+    {
+        wait();
+
+        // Pages the flush thread failed to send are still out of date on
+        // the panel, and frame_ holds them at least as new as front_.
+
+        std::lock_guard<std::mutex> lock{flushMutex_};
+
+        merge(dirty_, frontDirty_);
+        clean(frontDirty_);
+    }
+
+    OledTransaction transaction;
+    addUpdate(transaction, frame_, dirty_);
+
+    if (not transaction.empty())
+    {
+        send(transaction);
+        clean(dirty_);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::submit()
+{
+    {
+        std::lock_guard<std::mutex> lock{flushMutex_};
+
+        rethrow();
+
+        front_ = frame_;
+
+        // frontDirty_ may still hold pages from a frame that failed to
+        // send, which go out again with this one.
+
+        merge(frontDirty_, dirty_);
+
+        for (const auto& frontDirty : frontDirty_)
+        {
+            if (frontDirty.first <= frontDirty.last)
+            {
+                pending_ = true;
+            }
+        }
+
+        if (not flusher_.joinable())
+        {
+            flusher_ = std::thread{&OledDisplay::flush, this};
+        }
+    }
+
+    clean(dirty_);
+    flushCondition_.notify_all();
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::wait()
+{
+    std::unique_lock<std::mutex> lock{flushMutex_};
+
+    flushCondition_.wait(lock, [this] { return not (pending_ or busy_); });
+
+    rethrow();
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::addFrame(
+    OledTransaction& transaction,
+    const Frame& frame)
+{
+    OledCommandBatch commands;
+
+    commands.add(OLED_SET_COLUMN_ADDRESS, 0x00, Width - 1);
+    commands.add(OLED_SET_PAGE_ADDRESS, 0x00, Pages - 1);
+
+    transaction.addCommands(commands);
+    transaction.addData(frame.data(), frame.size());
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::addPages(
+    OledTransaction& transaction,
+    const Frame& frame,
+    const DirtyPages& dirty)
+{
+    OledCommandBatch commands;
+
+    for (auto page = 0 ; page < Pages ; ++page)
+    {
+        auto first = dirty[page].first;
+        auto last = dirty[page].last;
+
+        if (first <= last)
+        {
+            commands.clear();
+            commands.add(OLED_SET_COLUMN_ADDRESS, first, last);
+            commands.add(OLED_SET_PAGE_ADDRESS, page, page);
+
+            transaction.addCommands(commands);
+            transaction.addData(frame.data() + (page * Width) + first,
+                                last - first + 1);
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::addUpdate(
+    OledTransaction& transaction,
+    const Frame& frame,
+    const DirtyPages& dirty)
+{
+    int cost{0};
+
+    for (const auto& columns : dirty)
+    {
+        if (columns.first <= columns.last)
+        {
+            cost += WindowOverhead + (columns.last - columns.first + 1);
+        }
+    }
+
+    if (cost >= FrameCost)
+    {
+        addFrame(transaction, frame);
+    }
+    else if (cost > 0)
+    {
+        addPages(transaction, frame, dirty);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::clean(
+    DirtyPages& dirty)
+{
+    dirty.fill(DirtyColumns{Width, -1});
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::fillWith(
+    uint8_t value)
+{
+    for (auto page = 0 ; page < Pages ; ++page)
+    {
+        auto row = frame_.begin() + (page * Width);
+        auto first = 0;
+        auto last = Width - 1;
+
+        while ((first <= last) && (row[first] == value))
+        {
+            ++first;
+        }
+
+        while ((last >= first) && (row[last] == value))
+        {
+            --last;
+        }
+
+        if (first <= last)
+        {
+            std::fill(row + first, row + last + 1, value);
+            markDirty(page, first, last);
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::flush()
+{
+    std::unique_lock<std::mutex> lock{flushMutex_};
+
+    for (;;)
+    {
+        flushCondition_.wait(lock, [this] { return pending_ or stop_; });
+
+        if (not pending_)
+        {
+            break;
+        }
+
+        OledTransaction transaction;
+        addUpdate(transaction, front_, frontDirty_);
+
+        auto sent = frontDirty_;
+        clean(frontDirty_);
+        pending_ = false;
+        busy_ = true;
+
+        lock.unlock();
+
+        std::exception_ptr error;
+
+        try
+        {
+            send(transaction);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+
+        if (error)
+        {
+            // Keep the pages that were not sent, so that the next submit()
+            // or displayUpdate() sends them again.
+
+            error_ = error;
+            merge(frontDirty_, sent);
+        }
+
+        busy_ = false;
+
+        flushCondition_.notify_all();
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::init() const
+{
+    OledCommandBatch commands;
+
+    // Enable charge pump regulator - 8Dh, 14h
+
+    commands.add(OLED_ENABLE_CHARGE_PUMP_REGULATOR, 0x14);
+
+    // Set Memory Addressing Mode - 20h, 00h
+
+    commands.add(OLED_SET_MEMORY_ADDRESSING_MODE,
+                 OLED_HORIZONTAL_ADDRESSING_MODE);
+
+    // Set Osc Frequency D5h, 80h
+
+    commands.add(OLED_SET_OSC_FREQUENCY, 0x80);
+
+    // Set Display Offset - D3h, 00h
+
+    commands.add(OLED_SET_DISPLAY_OFFSET, 0x00);
+
+    // Set Display Start Line - 40h
+
+    commands.add(OLED_SET_DISPLAY_START_LINE_MASK | 0x00);
+
+    // Set Segment re-map - A0h/A1h
+
+    commands.add(OLED_SET_SEGMENT_REMAP_127);
+
+    // Set COM Output Scan Direction - C0, C8h
+
+    commands.add(OLED_SET_COM_OUTPUT_SCAN_DIRECTION_REMAP);
+
+    // Set COM Pins hardware configuration - DAh, 12h
+
+    commands.add(OLED_SET_COM_PINS_HARDWARE_CONFIGURATION, 0x12);
+
+    // Set Pre-charge Period D9h, F1h
+
+    commands.add(OLED_SET_PRECHARGE_PERIOD, 0xF1);
+
+    // Set Vcomh Deselect Level - DBh, 40h
+
+    commands.add(OLED_SET_VCOMH_DESELECT_LEVEL, 0x40);
+
+    // Disable Entire Display On - A4h
+
+    commands.add(OLED_SET_ENTIRE_DISPLAY_ON_RESUME);
+
+    // Set Normal Display - A6h
+
+    commands.add(OLED_SET_NORMAL_DISPLAY);
+
+    // Set Column Address - 21h, 00h, 7Fh
+
+    commands.add(OLED_SET_COLUMN_ADDRESS, 0x00, 0x7F);
+
+    // Set Page Address - 22h, 00h, 07h
+
+    commands.add(OLED_SET_PAGE_ADDRESS, 0x00, 0x07);
+
+    // Set Contrast Control - 81h, 7Fh
+
+    commands.add(OLED_SET_CONTRAST, 0x7F);
+
+    // Display On - AFh
+
+    commands.add(OLED_SET_DISPLAY_ON);
+
+    sendCommands(commands);
+
+    usleep(100000);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::markDirty(
+    int page,
+    int first,
+    int last)
+{
+    auto& dirty = dirty_[page];
+
+    if (dirty.first > dirty.last)
+    {
+        dirty.first = first;
+        dirty.last = last;
+    }
+    else
+    {
+        dirty.first = std::min(dirty.first, first);
+        dirty.last = std::max(dirty.last, last);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::merge(
+    DirtyPages& dirty,
+    const DirtyPages& more)
+{
+    for (auto page = 0 ; page < Pages ; ++page)
+    {
+        dirty[page].first = std::min(dirty[page].first, more[page].first);
+        dirty[page].last = std::max(dirty[page].last, more[page].last);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::rethrow()
+{
+    if (error_)
+    {
+        auto error = error_;
+        error_ = nullptr;
+
+        std::rethrow_exception(error);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::send(
+    const OledTransaction& transaction) const
+{
+    std::lock_guard<std::mutex> lock{sendMutex_};
+
+    transport_->send(transaction);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledDisplay::sendCommands(
+    const OledCommandBatch& commands) const
+{
+    OledTransaction transaction;
+    transaction.addCommands(commands);
+
+    send(transaction);
+}
+
@@ -0,0 +1,184 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_DISPLAY_H
+#define OLED_DISPLAY_H
+
+//------------------------------------------------------------------------
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "OledBitmap.h"
+#include "OledCommandBatch.h"
+#include "OledHardware.h"
+#include "OledPixel.h"
+#include "OledTransaction.h"
+#include "OledTransport.h"
+#include "point.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// The SSD1306 framebuffer, dirty tracking and command set, independent
+// of how the bytes reach the controller.
+
+class OledDisplay
+:
+    public OledHardware,
+    public OledPixel
+{
+public:
+
+    static constexpr int Width{128};
+    static constexpr int Height{64};
+    static constexpr int Pages{Height / 8};
+    static constexpr int FrameSize{Width * Pages};
+
+    // Approximate bytes on the wire spent setting up each window
+    // (column and page address commands plus the data message framing).
+    // displayUpdate() streams the whole frame when the dirty windows
+    // would cost at least as much.
+
+    static constexpr int WindowOverhead{10};
+
+    explicit OledDisplay(std::unique_ptr<OledTransport> transport);
+
+    virtual ~OledDisplay();
+
+    OledDisplay(const OledDisplay&) = delete;
+    OledDisplay& operator= (const OledDisplay&) = delete;
+
+    void clear() override;
+    void fill() override;
+    bool isSetPixel(SSD1306::OledPoint p) const override;
+    void setPixel(SSD1306::OledPoint p) override;
+    void unsetPixel(SSD1306::OledPoint p) override;
+    void xorPixel(SSD1306::OledPoint p) override;
+
+    int width() const override { return Width; }
+    int height() const override { return Height; }
+
+    OledRaster raster() override;
+    OledConstRaster raster() const override;
+    void rasterChanged(SSD1306::OledPoint p1,
+                       SSD1306::OledPoint p2) override;
+
+    OledBitmap<Width, Height> getBitmap() const;
+
+    void displayInverse() const override;
+    void displayNormal() const override;
+    void displayOff() const override;
+    void displayOn() const override;
+    void displaySetContrast(uint8_t contrast) const override;
+    void displayUpdate() override;
+
+    // Asynchronous update. submit() hands the current frame to a flush
+    // thread and returns at once, so that drawing can continue while it
+    // is sent. If the thread is still busy with an earlier frame, a
+    // frame waiting to be sent is replaced rather than queued. wait()
+    // blocks until every submitted frame has been sent. Both rethrow any
+    // error raised while sending; the pages that were not sent go out
+    // with the next submit() or displayUpdate().
+
+    void submit();
+    void wait();
+
+private:
+
+    // The frame is held in the controller's page-major GDDRAM order.
+
+    using Frame = std::array<uint8_t, FrameSize>;
+
+    // Range of columns changed in each page since the last update. The
+    // range is empty when first > last.
+
+    struct DirtyColumns
+    {
+        int first;
+        int last;
+    };
+
+    using DirtyPages = std::array<DirtyColumns, Pages>;
+
+    static void addFrame(OledTransaction& transaction, const Frame& frame);
+
+    static void addPages(OledTransaction& transaction,
+                         const Frame& frame,
+                         const DirtyPages& dirty);
+
+    static void addUpdate(OledTransaction& transaction,
+                          const Frame& frame,
+                          const DirtyPages& dirty);
+
+    static void clean(DirtyPages& dirty);
+    static void merge(DirtyPages& dirty, const DirtyPages& more);
+
+    void fillWith(uint8_t value);
+    void flush();
+    void init() const;
+    void markDirty(int page, int first, int last);
+    void rethrow();
+    void send(const OledTransaction& transaction) const;
+    void sendCommands(const OledCommandBatch& commands) const;
+
+    std::unique_ptr<OledTransport> transport_;
+    mutable std::mutex sendMutex_;
+
+    Frame frame_;
+    DirtyPages dirty_;
+
+    // The front buffer handed to the flush thread by submit(), guarded
+    // by flushMutex_.
+
+    Frame front_;
+    DirtyPages frontDirty_;
+    bool pending_;
+    bool busy_;
+    bool stop_;
+    std::exception_ptr error_;
+    std::mutex flushMutex_;
+    std::condition_variable flushCondition_;
+    std::thread flusher_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
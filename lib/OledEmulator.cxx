@@ -0,0 +1,453 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#include "OledEmulator.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+    // Control byte bits, I2C only.
+
+    constexpr uint8_t OLED_CONTROL_CONTINUATION{0x80};
+    constexpr uint8_t OLED_CONTROL_DATA{0x40};
+
+    //--------------------------------------------------------------------
+
+    // The number of parameter bytes that follow each command.
+
+    int
+    parameterCount(
+        uint8_t command)
+    {
+        switch (command)
+        {
+        case 0x20: // memory addressing mode
+        case 0x81: // contrast
+        case 0x8D: // charge pump
+        case 0xA8: // multiplex ratio
+        case 0xD3: // display offset
+        case 0xD5: // oscillator frequency
+        case 0xD9: // pre-charge period
+        case 0xDA: // COM pins configuration
+        case 0xDB: // VCOMH deselect level
+
+            return 1;
+
+        case 0x21: // column address
+        case 0x22: // page address
+        case 0xA3: // vertical scroll area
+
+            return 2;
+
+        case 0x29: // vertical and horizontal scroll
+        case 0x2A:
+
+            return 5;
+
+        case 0x26: // horizontal scroll
+        case 0x27:
+
+            return 6;
+
+        default:
+
+            return 0;
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledEmulator::OledEmulator()
+{
+    reset();
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::reset()
+{
+    gddram_.fill(0);
+
+    mode_ = AddressingMode::Page;
+    columnStart_ = 0;
+    columnEnd_ = Width - 1;
+    pageStart_ = 0;
+    pageEnd_ = Pages - 1;
+    column_ = 0;
+    page_ = 0;
+    pageModeColumn_ = 0;
+
+    contrast_ = 0x7F;
+    displayOn_ = false;
+    entireDisplayOn_ = false;
+    inverse_ = false;
+    segmentRemap_ = false;
+    comRemap_ = false;
+    startLine_ = 0;
+    displayOffset_ = 0;
+    multiplexRatio_ = Height;
+    unknownCommands_ = 0;
+
+    pending_.fill(0);
+    pendingLength_ = 0;
+    pendingNeeded_ = 0;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::i2cMessage(
+    const uint8_t* bytes,
+    int length)
+{
+    auto next = 0;
+
+    while (next < length)
+    {
+        auto control = bytes[next++];
+        auto isData = (control & OLED_CONTROL_DATA) != 0;
+
+        // With the continuation bit set, one byte follows and then
+        // another control byte; without it, the rest of the message.
+
+        auto count = (control & OLED_CONTROL_CONTINUATION)
+                   ? std::min(1, length - next)
+                   : length - next;
+
+        if (isData)
+        {
+            data(bytes + next, count);
+        }
+        else
+        {
+            commands(bytes + next, count);
+        }
+
+        next += count;
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::commands(
+    const uint8_t* bytes,
+    int length)
+{
+    for (auto i = 0 ; i < length ; ++i)
+    {
+        if (pendingLength_ == 0)
+        {
+            pendingNeeded_ = 1 + parameterCount(bytes[i]);
+        }
+
+        pending_[pendingLength_++] = bytes[i];
+
+        if (pendingLength_ == pendingNeeded_)
+        {
+            command(pending_.data());
+            pendingLength_ = 0;
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::data(
+    const uint8_t* bytes,
+    int length)
+{
+    for (auto i = 0 ; i < length ; ++i)
+    {
+        write(bytes[i]);
+    }
+}
+
+//------------------------------------------------------------------------
+
+bool
+SSD1306::OledEmulator::isLitPixel(
+    SSD1306::OledPoint p) const
+{
+    if ((p.x() < 0) || (p.x() >= Width) || (p.y() < 0) || (p.y() >= Height))
+    {
+        return false;
+    }
+
+    if ((not displayOn_) || (p.y() >= multiplexRatio_))
+    {
+        return false;
+    }
+
+    if (entireDisplayOn_)
+    {
+        return true;
+    }
+
+    auto row = comRemap_ ? p.y() : (multiplexRatio_ - 1 - p.y());
+    row = (row + startLine_ + displayOffset_) % Height;
+
+    auto column = segmentRemap_ ? p.x() : (Width - 1 - p.x());
+    auto byte = gddram_[((row / 8) * Width) + column];
+
+    return ((byte & (1 << (row % 8))) != 0) != inverse_;
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledEmulator::Image
+SSD1306::OledEmulator::image() const
+{
+    Image bitmap;
+
+    for (auto y = 0 ; y < Height ; ++y)
+    {
+        for (auto x = 0 ; x < Width ; ++x)
+        {
+            if (isLitPixel(OledPoint{x, y}))
+            {
+                bitmap.setPixel(OledPoint{x, y});
+            }
+        }
+    }
+
+    return bitmap;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::writePbm(
+    std::ostream& stream) const
+{
+    stream << "P4\n" << Width << " " << Height << "\n";
+
+    auto bitmap = image();
+    auto raster = bitmap.raster();
+
+    for (auto y = 0 ; y < Height ; ++y)
+    {
+        stream.write(reinterpret_cast<const char*>(raster.bytes) +
+                     (y * raster.stride),
+                     raster.stride);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::command(
+    const uint8_t* bytes)
+{
+    auto command = bytes[0];
+
+    if (command <= 0x0F)
+    {
+        pageModeColumn_ = (pageModeColumn_ & 0x70) | command;
+        column_ = pageModeColumn_;
+    }
+    else if (command <= 0x1F)
+    {
+        pageModeColumn_ = (pageModeColumn_ & 0x0F) | ((command & 0x07) << 4);
+        column_ = pageModeColumn_;
+    }
+    else if ((command >= 0x40) && (command <= 0x7F))
+    {
+        startLine_ = command & 0x3F;
+    }
+    else if ((command >= 0xB0) && (command <= 0xB7))
+    {
+        page_ = command & 0x07;
+    }
+    else if ((command >= 0xC0) && (command <= 0xCF))
+    {
+        comRemap_ = (command & 0x08) != 0;
+    }
+    else
+    {
+        switch (command)
+        {
+        case 0x20:
+
+            switch (bytes[1] & 0x03)
+            {
+            case 0x00:
+
+                mode_ = AddressingMode::Horizontal;
+                break;
+
+            case 0x01:
+
+                mode_ = AddressingMode::Vertical;
+                break;
+
+            case 0x02:
+
+                mode_ = AddressingMode::Page;
+                break;
+
+            default:
+
+                break;
+            }
+
+            break;
+
+        case 0x21:
+
+            columnStart_ = bytes[1] & 0x7F;
+            columnEnd_ = bytes[2] & 0x7F;
+            column_ = columnStart_;
+            break;
+
+        case 0x22:
+
+            pageStart_ = bytes[1] & 0x07;
+            pageEnd_ = bytes[2] & 0x07;
+            page_ = pageStart_;
+            break;
+
+        case 0x81:
+
+            contrast_ = bytes[1];
+            break;
+
+        case 0xA0:
+        case 0xA1:
+
+            segmentRemap_ = (command == 0xA1);
+            break;
+
+        case 0xA4:
+        case 0xA5:
+
+            entireDisplayOn_ = (command == 0xA5);
+            break;
+
+        case 0xA6:
+        case 0xA7:
+
+            inverse_ = (command == 0xA7);
+            break;
+
+        case 0xA8:
+
+            // Ratios below 16 are invalid and ignored by the controller.
+
+            if ((bytes[1] & 0x3F) >= 15)
+            {
+                multiplexRatio_ = (bytes[1] & 0x3F) + 1;
+            }
+
+            break;
+
+        case 0xAE:
+        case 0xAF:
+
+            displayOn_ = (command == 0xAF);
+            break;
+
+        case 0xD3:
+
+            displayOffset_ = bytes[1] & 0x3F;
+            break;
+
+        case 0x26: // scrolling
+        case 0x27:
+        case 0x29:
+        case 0x2A:
+        case 0x2E:
+        case 0x2F:
+        case 0xA3:
+        case 0x8D: // charge pump and timing
+        case 0xD5:
+        case 0xD9:
+        case 0xDA:
+        case 0xDB:
+        case 0xE3: // no operation
+
+            break;
+
+        default:
+
+            ++unknownCommands_;
+            break;
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledEmulator::write(
+    uint8_t byte)
+{
+    gddram_[(page_ * Width) + column_] = byte;
+
+    switch (mode_)
+    {
+    case AddressingMode::Horizontal:
+
+        if (column_ >= columnEnd_)
+        {
+            column_ = columnStart_;
+            page_ = (page_ >= pageEnd_) ? pageStart_ : page_ + 1;
+        }
+        else
+        {
+            ++column_;
+        }
+
+        break;
+
+    case AddressingMode::Vertical:
+
+        if (page_ >= pageEnd_)
+        {
+            page_ = pageStart_;
+            column_ = (column_ >= columnEnd_) ? columnStart_ : column_ + 1;
+        }
+        else
+        {
+            ++page_;
+        }
+
+        break;
+
+    case AddressingMode::Page:
+
+        column_ = (column_ >= Width - 1) ? pageModeColumn_ : column_ + 1;
+        break;
+    }
+}
@@ -0,0 +1,159 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_EMULATOR_H
+#define OLED_EMULATOR_H
+
+//------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+
+#include "OledBitmap.h"
+#include "point.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// A software SSD1306 that decodes the bytes a display would receive and
+// keeps its own GDDRAM, so that everything above the bus can be run and
+// checked without hardware.
+//
+// It models the memory addressing modes and their column and page
+// pointers, the page addressing mode start address commands, contrast,
+// inverse, entire display on, display on and off, segment remap, COM
+// scan direction, display start line, display offset and multiplex
+// ratio. Scrolling and timing commands are accepted and ignored.
+//
+// image() is what the panel would show. It is upright for the segment
+// remap and COM scan direction that OledDisplay selects, and lit pixels
+// are set. The emulator is not thread safe; with OledDisplay::submit(),
+// call wait() before looking at it.
+
+class OledEmulator
+{
+public:
+
+    static constexpr int Width{128};
+    static constexpr int Height{64};
+    static constexpr int Pages{Height / 8};
+
+    enum class AddressingMode
+    {
+        Horizontal,
+        Vertical,
+        Page
+    };
+
+    using Gddram = std::array<uint8_t, Width * Pages>;
+    using Image = OledBitmap<Width, Height>;
+
+    OledEmulator();
+
+    // Return to the power on state, with GDDRAM cleared.
+
+    void reset();
+
+    // One I2C write: a control byte, then commands or data as the
+    // control byte says, which may itself be followed by further control
+    // bytes when its continuation bit is set.
+
+    void i2cMessage(const uint8_t* bytes, int length);
+
+    // Bytes sent with D/C# low and high respectively, as over SPI.
+
+    void commands(const uint8_t* bytes, int length);
+    void data(const uint8_t* bytes, int length);
+
+    AddressingMode addressingMode() const { return mode_; }
+    int column() const { return column_; }
+    int page() const { return page_; }
+    uint8_t contrast() const { return contrast_; }
+    bool isDisplayOn() const { return displayOn_; }
+    bool isEntireDisplayOn() const { return entireDisplayOn_; }
+    bool isInverse() const { return inverse_; }
+
+    // Command bytes that are not SSD1306 commands.
+
+    int unknownCommands() const { return unknownCommands_; }
+
+    const Gddram& gddram() const { return gddram_; }
+
+    bool isLitPixel(SSD1306::OledPoint p) const;
+    Image image() const;
+
+    // The image as a binary PBM, lit pixels black.
+
+    void writePbm(std::ostream& stream) const;
+
+private:
+
+    void command(const uint8_t* bytes);
+    void write(uint8_t byte);
+
+    Gddram gddram_;
+
+    AddressingMode mode_;
+    int columnStart_;
+    int columnEnd_;
+    int pageStart_;
+    int pageEnd_;
+    int column_;
+    int page_;
+    int pageModeColumn_;
+
+    uint8_t contrast_;
+    bool displayOn_;
+    bool entireDisplayOn_;
+    bool inverse_;
+    bool segmentRemap_;
+    bool comRemap_;
+    int startLine_;
+    int displayOffset_;
+    int multiplexRatio_;
+    int unknownCommands_;
+
+    // A command whose parameter bytes have not all arrived yet.
+
+    std::array<uint8_t, 8> pending_;
+    int pendingLength_;
+    int pendingNeeded_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
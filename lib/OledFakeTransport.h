@@ -0,0 +1,76 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_FAKE_TRANSPORT_H
+#define OLED_FAKE_TRANSPORT_H
+
+//------------------------------------------------------------------------
+
+#include <functional>
+
+#include "OledTransport.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+using SendFunction = std::function<void(const OledTransaction&)>;
+
+//------------------------------------------------------------------------
+
+// A transport that hands every transaction to a function instead of a
+// bus, so that an OledDisplay can be driven and inspected on any Linux
+// machine.
+
+class OledFakeTransport
+:
+    public OledTransport
+{
+public:
+
+    explicit OledFakeTransport(
+        SendFunction on_send = [](const OledTransaction&) {});
+
+    ~OledFakeTransport() override;
+
+    void send(const OledTransaction& transaction) override;
+
+private:
+
+    SendFunction on_send_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,528 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include "FileDescriptor.h"
+#include "OledFont.h"
+#include "OledText.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+uint16_t
+read16(
+    const uint8_t* bytes)
+{
+    return bytes[0] | (bytes[1] << 8);
+}
+
+//-------------------------------------------------------------------------
+
+uint32_t
+read32(
+    const uint8_t* bytes)
+{
+    return uint32_t(bytes[0])
+         | (uint32_t(bytes[1]) << 8)
+         | (uint32_t(bytes[2]) << 16)
+         | (uint32_t(bytes[3]) << 24);
+}
+
+//-------------------------------------------------------------------------
+
+void
+invalid(
+    const std::string& path,
+    const std::string& reason)
+{
+    throw std::runtime_error(path + " is not a valid font: " + reason);
+}
+
+//-------------------------------------------------------------------------
+
+// How the glyph itself is drawn. In GlyphMode::Opaque the cell has
+// already been drawn in oppositeStyle(style), as with the fixed fonts,
+// so the glyph only has to be drawn over it in style.
+
+SSD1306::OledGlyphOp
+glyphOp(
+    SSD1306::PixelStyle style,
+    SSD1306::GlyphMode mode)
+{
+    using SSD1306::GlyphMode;
+    using SSD1306::PixelStyle;
+
+    auto glyphStyle = style;
+
+    if (mode == GlyphMode::Opaque)
+    {
+        switch (style)
+        {
+        case PixelStyle::Set:
+        case PixelStyle::Unset:
+
+            break;
+
+        case PixelStyle::Xor:
+
+            // The cell, glyph included, has already been inverted.
+
+            glyphStyle = PixelStyle::None;
+            break;
+
+        case PixelStyle::None:
+
+            // Undo the cell's Xor where the glyph is.
+
+            glyphStyle = PixelStyle::Xor;
+            break;
+        }
+    }
+
+    return SSD1306::OledGlyphOp{glyphStyle, GlyphMode::Transparent};
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledConstRaster
+SSD1306::OledFont::Glyph::raster() const
+{
+    return OledConstRaster{OledLayout::RowMajor,
+                           width,
+                           height,
+                           (width + 7) / 8,
+                           bitmap};
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledFont::OledFont(
+    const std::string& path)
+:
+    data_{nullptr},
+    size_{0},
+    ascent_{0},
+    descent_{0},
+    defaultCode_{0},
+    rangeCount_{0},
+    glyphCount_{0},
+    bitmapSize_{0},
+    ranges_{nullptr},
+    glyphs_{nullptr},
+    bitmaps_{nullptr},
+    blocks_{}
+{
+    FileDescriptor file{::open(path.c_str(), O_RDONLY)};
+
+    if (file.fd() == -1)
+    {
+        std::string what( "open "
+                        + path
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    struct stat status;
+
+    if (::fstat(file.fd(), &status) == -1)
+    {
+        std::string what( "fstat "
+                        + path
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    if (status.st_size < OledFontFormat::HeaderSize)
+    {
+        invalid(path, "too short");
+    }
+
+    size_ = status.st_size;
+
+    auto data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file.fd(), 0);
+
+    if (data == MAP_FAILED)
+    {
+        std::string what( "mmap "
+                        + path
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    data_ = static_cast<const uint8_t*>(data);
+
+    try
+    {
+        validate(path);
+    }
+    catch (...)
+    {
+        ::munmap(data, size_);
+        throw;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledFont::~OledFont()
+{
+    ::munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+//-------------------------------------------------------------------------
+
+bool
+SSD1306::OledFont::hasGlyph(
+    uint32_t code) const
+{
+    uint32_t index;
+
+    return find(code, index);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledFont::Glyph
+SSD1306::OledFont::glyph(
+    uint32_t code) const
+{
+    uint32_t index;
+
+    if (find(code, index) || find(defaultCode_, index))
+    {
+        return glyphAt(index);
+    }
+
+    return Glyph{0, 0, 0, 0, 0, nullptr};
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledOverhang
+SSD1306::OledFont::overhang(
+    uint32_t code) const
+{
+    auto g = glyph(code);
+
+    if ((g.width == 0) || (g.height == 0))
+    {
+        return OledOverhang{0, 0, 0, 0};
+    }
+
+    auto top = ascent_ - g.top;
+
+    return OledOverhang{std::max(0, -g.left),
+                        std::max(0, -top),
+                        std::max(0, g.left + g.width - g.advance),
+                        std::max(0, top + g.height - lineHeight())};
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledPoint
+SSD1306::OledFont::drawChar(
+    const OledPoint& p,
+    uint32_t code,
+    PixelStyle style,
+    OledPixel& pixels,
+    GlyphMode mode) const
+{
+    return drawChar_(p, code, style, mode, glyphOp(style, mode), pixels);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledPoint
+SSD1306::OledFont::drawString(
+    const OledPoint& p,
+    const std::string& string,
+    PixelStyle style,
+    OledPixel& pixels,
+    GlyphMode mode) const
+{
+    OledPoint position{p};
+
+    auto op = glyphOp(style, mode);
+
+    // Nothing is drawn, but the position still moves on.
+
+    auto drawsNothing = (mode == GlyphMode::Transparent) && op.drawsNothing();
+
+    auto next = string.data();
+    auto end = next + string.size();
+
+    while (next != end)
+    {
+        if (*next == '\n')
+        {
+            position.set(p.x(), position.y() + lineHeight());
+            ++next;
+        }
+        else
+        {
+            uint32_t code;
+
+            if (not decodeUtf8(next, end, code))
+            {
+                code = invalidByte(code);
+            }
+
+            if (drawsNothing)
+            {
+                position.set(position.x() + advance(code), position.y());
+            }
+            else
+            {
+                position = drawChar_(position, code, style, mode, op, pixels);
+            }
+        }
+    }
+
+    return position;
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledPoint
+SSD1306::OledFont::drawChar_(
+    const OledPoint& p,
+    uint32_t code,
+    PixelStyle style,
+    GlyphMode mode,
+    const OledGlyphOp& op,
+    OledPixel& pixels) const
+{
+    auto g = glyph(code);
+
+    OledPoint next{p.x() + g.advance, p.y()};
+    OledPoint origin{p.x() + g.left, p.y() + ascent_ - g.top};
+
+    if ((mode == GlyphMode::Opaque) && (g.advance > 0) && (lineHeight() > 0))
+    {
+        OledPoint corner{next.x() - 1, p.y() + lineHeight() - 1};
+
+        pixels.rectangle(p, corner, oppositeStyle(style));
+    }
+
+    if (not op.drawsNothing())
+    {
+        op.draw(origin, g.raster(), pixels);
+    }
+
+    return next;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+SSD1306::OledFont::find(
+    uint32_t code,
+    uint32_t& index) const
+{
+    uint32_t first = 0;
+    uint32_t last = rangeCount_;
+
+    if ((code >> 8) < IndexedBlocks)
+    {
+        first = blocks_[code >> 8];
+        last = std::min(blocks_[(code >> 8) + 1] + 1, rangeCount_);
+    }
+
+    // Binary search for the last range starting at or before code.
+
+    uint32_t low = first;
+    uint32_t high = last;
+
+    while (low < high)
+    {
+        auto middle = low + (high - low) / 2;
+
+        if (read32(ranges_ + (middle * OledFontFormat::RangeSize)) <= code)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    if (low == first)
+    {
+        return false;
+    }
+
+    auto range = ranges_ + ((low - 1) * OledFontFormat::RangeSize);
+    auto offset = code - read32(range);
+
+    if (offset >= read32(range + 4))
+    {
+        return false;
+    }
+
+    // Glyph records are checked here rather than when the font is loaded,
+    // which would page in the whole glyph table.
+
+    auto glyph = glyphs_ + ((read32(range + 8) + offset)
+                            * OledFontFormat::GlyphSize);
+    auto bytes = uint64_t((glyph[4] + 7) / 8) * glyph[5];
+
+    if (read32(glyph) + bytes > bitmapSize_)
+    {
+        return false;
+    }
+
+    index = read32(range + 8) + offset;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledFont::Glyph
+SSD1306::OledFont::glyphAt(
+    uint32_t index) const
+{
+    auto glyph = glyphs_ + (index * OledFontFormat::GlyphSize);
+
+    return Glyph{glyph[4],
+                 glyph[5],
+                 static_cast<int8_t>(glyph[6]),
+                 static_cast<int8_t>(glyph[7]),
+                 glyph[8],
+                 bitmaps_ + read32(glyph)};
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledFont::validate(
+    const std::string& path)
+{
+    if (std::memcmp(data_,
+                    OledFontFormat::Magic,
+                    sizeof(OledFontFormat::Magic)) != 0)
+    {
+        invalid(path, "bad magic number");
+    }
+
+    if (read16(data_ + 4) != OledFontFormat::Version)
+    {
+        invalid(path, "unsupported version");
+    }
+
+    uint64_t headerSize = read16(data_ + 6);
+
+    if (headerSize < OledFontFormat::HeaderSize)
+    {
+        invalid(path, "header too short");
+    }
+
+    ascent_ = static_cast<int16_t>(read16(data_ + 8));
+    descent_ = static_cast<int16_t>(read16(data_ + 10));
+    defaultCode_ = read32(data_ + 12);
+    rangeCount_ = read32(data_ + 16);
+    glyphCount_ = read32(data_ + 20);
+    bitmapSize_ = read32(data_ + 24);
+
+    // Sizes are summed in 64 bits so that no count can wrap them.
+
+    auto rangesSize = uint64_t(rangeCount_) * OledFontFormat::RangeSize;
+    auto glyphsSize = uint64_t(glyphCount_) * OledFontFormat::GlyphSize;
+
+    if (headerSize + rangesSize + glyphsSize + bitmapSize_ > size_)
+    {
+        invalid(path, "truncated");
+    }
+
+    ranges_ = data_ + headerSize;
+    glyphs_ = ranges_ + rangesSize;
+    bitmaps_ = glyphs_ + glyphsSize;
+
+    uint64_t nextCode = 0;
+
+    for (uint32_t i = 0 ; i < rangeCount_ ; ++i)
+    {
+        auto range = ranges_ + (i * OledFontFormat::RangeSize);
+        auto first = read32(range);
+        auto count = read32(range + 4);
+
+        if ((first < nextCode) ||
+            (uint64_t(read32(range + 8)) + count > glyphCount_))
+        {
+            invalid(path, "bad range table");
+        }
+
+        nextCode = uint64_t(first) + count;
+    }
+
+    // blocks_[block] is the first range that ends after the start of
+    // block, so a code point in block can only be in the ranges from
+    // there to blocks_[block + 1].
+
+    auto rangeEnd = [this](uint32_t range)
+    {
+        auto entry = ranges_ + (range * OledFontFormat::RangeSize);
+
+        return uint64_t(read32(entry)) + read32(entry + 4);
+    };
+
+    uint32_t range = 0;
+
+    for (uint32_t block = 0 ; block <= IndexedBlocks ; ++block)
+    {
+        while ((range < rangeCount_) && (rangeEnd(range) <= (block << 8)))
+        {
+            ++range;
+        }
+
+        blocks_[block] = range;
+    }
+}
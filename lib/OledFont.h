@@ -0,0 +1,220 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_FONT_H
+#define OLED_FONT_H
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "OledGlyph.h"
+#include "OledPixel.h"
+#include "OledTypeface.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// The binary font format. All values are little-endian.
+//
+// header (HeaderSize bytes)
+//
+//   0  char[4]  magic "OLFN"
+//   4  uint16   version
+//   6  uint16   header size
+//   8  int16    ascent - pixels above the baseline
+//  10  int16    descent - pixels below the baseline
+//  12  uint32   code point drawn for characters the font lacks
+//  16  uint32   number of ranges
+//  20  uint32   number of glyphs
+//  24  uint32   size of the bitmap data in bytes
+//  28  uint32   reserved
+//
+// ranges (RangeSize bytes each, sorted by first code point, disjoint)
+//
+//   0  uint32   first code point
+//   4  uint32   number of code points
+//   8  uint32   index of the glyph for the first code point
+//
+// glyphs (GlyphSize bytes each)
+//
+//   0  uint32   offset of the bitmap in the bitmap data
+//   4  uint8    width of the bitmap
+//   5  uint8    height of the bitmap
+//   6  int8     left - pixels from the pen position to the bitmap
+//   7  int8     top - pixels from the baseline up to the top of the bitmap
+//   8  uint8    advance - pixels to move the pen on to the next glyph
+//   9  uint8[3] reserved
+//
+// bitmap data
+//
+//   Each bitmap is row-major, (width + 7) / 8 bytes per row, with the
+//   leftmost pixel in the most significant bit.
+
+namespace OledFontFormat
+{
+    constexpr char Magic[4]{'O', 'L', 'F', 'N'};
+    constexpr uint16_t Version{1};
+    constexpr int HeaderSize{32};
+    constexpr int RangeSize{12};
+    constexpr int GlyphSize{12};
+}
+
+//-------------------------------------------------------------------------
+
+// A proportional bitmap font, mapped read-only from a file in the format
+// above. Nothing is copied: the kernel pages in the parts of the file
+// that are actually drawn. Fonts are produced by the oledfont tool from
+// BDF or PSF fonts.
+
+class OledFont
+:
+    public OledTypeface
+{
+public:
+
+    struct Glyph
+    {
+        int width;
+        int height;
+        int left;
+        int top;
+        int advance;
+        const uint8_t* bitmap;
+
+        OledConstRaster raster() const;
+    };
+
+    explicit OledFont(const std::string& path);
+
+    ~OledFont() override;
+
+    OledFont(const OledFont&) = delete;
+    OledFont& operator= (const OledFont&) = delete;
+
+    int ascent() const { return ascent_; }
+    int descent() const { return descent_; }
+    int lineHeight() const override { return ascent_ + descent_; }
+
+    // The header and range table are checked when the font is loaded;
+    // each glyph record only when it is looked up. A record whose bitmap
+    // lies outside the bitmap data counts as missing.
+
+    bool hasGlyph(uint32_t code) const;
+
+    // The glyph for code, or for the font's default code point when it
+    // has none. If it has neither, an empty glyph that does not advance.
+
+    Glyph glyph(uint32_t code) const;
+
+    int advance(uint32_t code) const override { return glyph(code).advance; }
+
+    // Glyphs may reach left of the pen, beyond the advance, above the
+    // ascent or below the descent.
+
+    OledOverhang overhang(uint32_t code) const override;
+
+    // p is the top left of the line, ascent() pixels above the baseline.
+    // In GlyphMode::Opaque the whole cell, advance wide and lineHeight()
+    // high, is drawn. Both return the position of the next character.
+
+    OledPoint
+    drawChar(
+        const OledPoint& p,
+        uint32_t code,
+        PixelStyle style,
+        OledPixel& pixels,
+        GlyphMode mode = GlyphMode::Opaque) const override;
+
+    // string is UTF-8; '\n' starts a new line. Bytes that are not UTF-8
+    // are drawn as invalidByte(), which is ReplacementCharacter.
+
+    OledPoint
+    drawString(
+        const OledPoint& p,
+        const std::string& string,
+        PixelStyle style,
+        OledPixel& pixels,
+        GlyphMode mode = GlyphMode::Opaque) const;
+
+private:
+
+    // Code points below IndexedBlocks * 256 are looked up through an
+    // index of the ranges that reach into each block of 256 code points,
+    // so that only those few ranges are searched.
+
+    static constexpr uint32_t IndexedBlocks{256};
+
+    // op is how the glyph is drawn, resolved once for a whole string; in
+    // GlyphMode::Opaque the cell is first drawn in oppositeStyle(style).
+
+    OledPoint
+    drawChar_(
+        const OledPoint& p,
+        uint32_t code,
+        PixelStyle style,
+        GlyphMode mode,
+        const OledGlyphOp& op,
+        OledPixel& pixels) const;
+
+    bool find(uint32_t code, uint32_t& index) const;
+    Glyph glyphAt(uint32_t index) const;
+    void validate(const std::string& path);
+
+    const uint8_t* data_;
+    size_t size_;
+
+    int ascent_;
+    int descent_;
+    uint32_t defaultCode_;
+    uint32_t rangeCount_;
+    uint32_t glyphCount_;
+    uint32_t bitmapSize_;
+
+    const uint8_t* ranges_;
+    const uint8_t* glyphs_;
+    const uint8_t* bitmaps_;
+
+    std::array<uint32_t, IndexedBlocks + 1> blocks_;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
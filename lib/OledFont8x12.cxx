@@ -25,8 +25,11 @@
 //
 //-------------------------------------------------------------------------
 
+#include <cstring>
+
 #include "OledFont8x12.h"
 #include "OledPixel.h"
+#include "OledText.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
@@ -3624,6 +3627,11 @@ constexpr uint8_t font8x12[256][sc_fontHeight8x12] =
     }
 };
 
+// The same glyphs in the display's page-major order, transposed by the
+// compiler rather than at run time.
+
+constexpr auto font8x12Pages = pageFont(font8x12);
+
 //-------------------------------------------------------------------------
 
 } // namespace SSD1306
@@ -3635,29 +3643,10 @@ SSD1306::drawChar8x12(
     const OledPoint& p,
     uint8_t c,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
-    PixelStyle opposite = oppositeStyle(style);
-
-    for (int16_t j = 0 ; j < sc_fontHeight8x12 ; ++j)
-    {
-        uint8_t byte = font8x12[c][j];
-
-        if (byte != 0)
-        {
-            for (int16_t i = 0 ; i < sc_fontWidth8x12 ; ++i)
-            {
-                if ((byte >> (sc_fontWidth8x12 - i - 1)) & 1 )
-                {
-                    oled.pixel(OledPoint(p.x() + i, p.y() + j), style);
-                }
-                else
-                {
-                    oled.pixel(OledPoint(p.x() + i, p.y() + j), opposite);
-                }
-            }
-        }
-    }
+    drawGlyph(p, font8x12Pages.glyph(c), style, mode, oled);
 
     return OledPoint(p.x() + sc_fontWidth8x12, p.y());
 }
@@ -3669,31 +3658,43 @@ SSD1306::drawString8x12(
     const OledPoint& p,
     const char* string,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
     OledPoint position{p};
 
     if (string != nullptr)
     {
+        OledGlyphOp op{style, mode};
         OledPoint start{p};
+        auto end = string + std::strlen(string);
 
-        while (*string != '\0')
+        while (string != end)
         {
             if (*string == '\n')
             {
                 position.set(
                     start.x(),
                     position.y() + sc_fontHeight8x12);
+                ++string;
             }
             else
             {
-                drawChar8x12(position, *string, style, oled);
+                uint32_t code;
+
+                auto c = decodeUtf8(string, end, code)
+                       ? codePage437(code)
+                       : static_cast<uint8_t>(code);
+
+                if (not op.drawsNothing())
+                {
+                    op.draw(position, font8x12Pages.glyph(c), oled);
+                }
 
                 position.set(
                     position.x() + sc_fontWidth8x12,
                     position.y());
             }
-            ++string;
         }
     }
 
@@ -3707,8 +3708,30 @@ SSD1306::drawString8x12(
     const OledPoint& p,
      const std::string& string,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
-    return drawString8x12(p, string.c_str(), style, oled);
+    return drawString8x12(p, string.c_str(), style, oled, mode);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledSize
+SSD1306::measureString8x12(
+    const std::string& string)
+{
+    return measureString(typeface8x12(), string);
+}
+
+//-------------------------------------------------------------------------
+
+const SSD1306::OledTypeface&
+SSD1306::typeface8x12()
+{
+    static const OledFixedTypeface typeface{sc_fontWidth8x12,
+                                            sc_fontHeight8x12,
+                                            drawChar8x12};
+
+    return typeface;
 }
 
@@ -33,7 +33,10 @@
 #include <cstdint>
 #include <string>
 
+#include "OledGlyph.h"
 #include "OledPixel.h"
+#include "OledTextLayout.h"
+#include "OledTypeface.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
@@ -53,21 +56,36 @@ drawChar8x12(
     const OledPoint& p,
     uint8_t c,
     PixelStyle style,
-    OledPixel& pixels);
+    OledPixel& pixels,
+    GlyphMode mode = GlyphMode::Opaque);
+
+// string is UTF-8, drawn with the code page 437 glyphs of the font and
+// '?' for characters it lacks. Bytes that are not UTF-8 are drawn as
+// code page 437, so strings such as "\xFD" still work.
 
 OledPoint
 drawString8x12(
     const OledPoint& p,
     const char* string,
     PixelStyle style,
-    OledPixel& pixels);
+    OledPixel& pixels,
+    GlyphMode mode = GlyphMode::Opaque);
 
 OledPoint
 drawString8x12(
     const OledPoint& p,
     const std::string& string,
     PixelStyle style,
-    OledPixel& pixels);
+    OledPixel& pixels,
+    GlyphMode mode = GlyphMode::Opaque);
+
+// The size of string as drawn by drawString8x12().
+
+OledSize measureString8x12(const std::string& string);
+
+// The font as a typeface, for OledTextLayout.
+
+const OledTypeface& typeface8x12();
 
 //-------------------------------------------------------------------------
 
@@ -25,8 +25,11 @@
 //
 //-------------------------------------------------------------------------
 
+#include <cstring>
+
 #include "OledFont8x16.h"
 #include "OledPixel.h"
+#include "OledText.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
@@ -4648,6 +4651,11 @@ constexpr uint8_t font8x16[256][sc_fontHeight8x16] =
     }
 };
 
+// The same glyphs in the display's page-major order, transposed by the
+// compiler rather than at run time.
+
+constexpr auto font8x16Pages = pageFont(font8x16);
+
 //-------------------------------------------------------------------------
 
 } // namespace SSD1306
@@ -4659,29 +4667,10 @@ SSD1306::drawChar8x16(
     const OledPoint& p,
     uint8_t c,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
-    PixelStyle opposite = oppositeStyle(style);
-
-    for (int16_t j = 0 ; j < sc_fontHeight8x16 ; ++j)
-    {
-        uint8_t byte = font8x16[c][j];
-
-        if (byte != 0)
-        {
-            for (int16_t i = 0 ; i < sc_fontWidth8x16 ; ++i)
-            {
-                if ((byte >> (sc_fontWidth8x16 - i - 1)) & 1 )
-                {
-                    oled.pixel(OledPoint(p.x() + i, p.y() + j), style);
-                }
-                else
-                {
-                    oled.pixel(OledPoint(p.x() + i, p.y() + j), opposite);
-                }
-            }
-        }
-    }
+    drawGlyph(p, font8x16Pages.glyph(c), style, mode, oled);
 
     return OledPoint(p.x() + sc_fontWidth8x16, p.y());
 }
@@ -4693,31 +4682,43 @@ SSD1306::drawString8x16(
     const OledPoint& p,
     const char* string,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
     OledPoint position{p};
 
     if (string != nullptr)
     {
+        OledGlyphOp op{style, mode};
         OledPoint start{p};
+        auto end = string + std::strlen(string);
 
-        while (*string != '\0')
+        while (string != end)
         {
             if (*string == '\n')
             {
                 position.set(
                     start.x(),
                     position.y() + sc_fontHeight8x16);
+                ++string;
             }
             else
             {
-                drawChar8x16(position, *string, style, oled);
+                uint32_t code;
+
+                auto c = decodeUtf8(string, end, code)
+                       ? codePage437(code)
+                       : static_cast<uint8_t>(code);
+
+                if (not op.drawsNothing())
+                {
+                    op.draw(position, font8x16Pages.glyph(c), oled);
+                }
 
                 position.set(
                     position.x() + sc_fontWidth8x16,
                     position.y());
             }
-            ++string;
         }
     }
 
@@ -4731,8 +4732,30 @@ SSD1306::drawString8x16(
     const OledPoint& p,
      const std::string& string,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
-    return drawString8x16(p, string.c_str(), style, oled);
+    return drawString8x16(p, string.c_str(), style, oled, mode);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledSize
+SSD1306::measureString8x16(
+    const std::string& string)
+{
+    return measureString(typeface8x16(), string);
+}
+
+//-------------------------------------------------------------------------
+
+const SSD1306::OledTypeface&
+SSD1306::typeface8x16()
+{
+    static const OledFixedTypeface typeface{sc_fontWidth8x16,
+                                            sc_fontHeight8x16,
+                                            drawChar8x16};
+
+    return typeface;
 }
 
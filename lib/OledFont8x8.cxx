@@ -25,8 +25,11 @@
 //
 //-------------------------------------------------------------------------
 
+#include <cstring>
+
 #include "OledFont8x8.h"
 #include "OledPixel.h"
+#include "OledText.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
@@ -2600,6 +2603,11 @@ constexpr uint8_t font8x8[256][sc_fontHeight8x8] =
     }
 };
 
+// The same glyphs in the display's page-major order, transposed by the
+// compiler rather than at run time.
+
+constexpr auto font8x8Pages = pageFont(font8x8);
+
 //-------------------------------------------------------------------------
 
 } // namespace SSD1306
@@ -2611,29 +2619,10 @@ SSD1306::drawChar8x8(
     const OledPoint& p,
     uint8_t c,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
-    PixelStyle opposite = oppositeStyle(style);
-
-    for (int16_t j = 0 ; j < sc_fontHeight8x8 ; ++j)
-    {
-        uint8_t byte = font8x8[c][j];
-
-        if (byte != 0)
-        {
-            for (int16_t i = 0 ; i < sc_fontWidth8x8 ; ++i)
-            {
-                if ((byte >> (sc_fontWidth8x8 - i - 1)) & 1 )
-                {
-                    oled.pixel(OledPoint(p.x() + i, p.y() + j), style);
-                }
-                else
-                {
-                    oled.pixel(OledPoint(p.x() + i, p.y() + j), opposite);
-                }
-            }
-        }
-    }
+    drawGlyph(p, font8x8Pages.glyph(c), style, mode, oled);
 
     return OledPoint(p.x() + sc_fontWidth8x8, p.y());
 }
@@ -2645,31 +2634,43 @@ SSD1306::drawString8x8(
     const OledPoint& p,
     const char* string,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
     OledPoint position{p};
 
     if (string != nullptr)
     {
+        OledGlyphOp op{style, mode};
         OledPoint start{p};
+        auto end = string + std::strlen(string);
 
-        while (*string != '\0')
+        while (string != end)
         {
             if (*string == '\n')
             {
                 position.set(
                     start.x(),
                     position.y() + sc_fontHeight8x8);
+                ++string;
             }
             else
             {
-                drawChar8x8(position, *string, style, oled);
+                uint32_t code;
+
+                auto c = decodeUtf8(string, end, code)
+                       ? codePage437(code)
+                       : static_cast<uint8_t>(code);
+
+                if (not op.drawsNothing())
+                {
+                    op.draw(position, font8x8Pages.glyph(c), oled);
+                }
 
                 position.set(
                     position.x() + sc_fontWidth8x8,
                     position.y());
             }
-            ++string;
         }
     }
 
@@ -2683,8 +2684,30 @@ SSD1306::drawString8x8(
     const OledPoint& p,
      const std::string& string,
     PixelStyle style,
-    OledPixel& oled)
+    OledPixel& oled,
+    GlyphMode mode)
 {
-    return drawString8x8(p, string.c_str(), style, oled);
+    return drawString8x8(p, string.c_str(), style, oled, mode);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledSize
+SSD1306::measureString8x8(
+    const std::string& string)
+{
+    return measureString(typeface8x8(), string);
+}
+
+//-------------------------------------------------------------------------
+
+const SSD1306::OledTypeface&
+SSD1306::typeface8x8()
+{
+    static const OledFixedTypeface typeface{sc_fontWidth8x8,
+                                            sc_fontHeight8x8,
+                                            drawChar8x8};
+
+    return typeface;
 }
 
@@ -0,0 +1,176 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "OledFramePacer.h"
+
+//------------------------------------------------------------------------
+
+SSD1306::OledFramePacer::OledFramePacer(
+    OledHardware& hardware,
+    double fps)
+:
+    hardware_(hardware),
+    timer_{-1},
+    pending_{false},
+    statistics_{0, 0, 0}
+{
+    if (not (fps > 0.0))
+    {
+        throw std::invalid_argument("frame rate must be greater than zero");
+    }
+
+    timer_ = FileDescriptor{timerfd_create(CLOCK_MONOTONIC,
+                                           TFD_NONBLOCK | TFD_CLOEXEC)};
+
+    if (timer_.fd() == -1)
+    {
+        std::string what( "timerfd_create " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    auto period = static_cast<long long>(1e9 / fps);
+
+    itimerspec spec;
+
+    spec.it_interval.tv_sec = period / 1000000000LL;
+    spec.it_interval.tv_nsec = period % 1000000000LL;
+
+    // The first deadline is now.
+
+    spec.it_value.tv_sec = 0;
+    spec.it_value.tv_nsec = 1;
+
+    if (timerfd_settime(timer_.fd(), 0, &spec, nullptr) == -1)
+    {
+        std::string what( "timerfd_settime " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledFramePacer::update()
+{
+    auto ticks = expirations();
+
+    if (ticks > 0)
+    {
+        send();
+    }
+    else if (pending_)
+    {
+        ++statistics_.coalesced;
+    }
+    else
+    {
+        pending_ = true;
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledFramePacer::wait()
+{
+    pollfd pfd{timer_.fd(), POLLIN, 0};
+
+    if (::poll(&pfd, 1, -1) == -1)
+    {
+        // Let the caller see a signal, such as a request to stop.
+
+        if (errno == EINTR)
+        {
+            return;
+        }
+
+        std::string what( "poll " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    auto ticks = expirations();
+
+    if (pending_ and (ticks > 0))
+    {
+        send();
+    }
+}
+
+//------------------------------------------------------------------------
+
+uint64_t
+SSD1306::OledFramePacer::expirations()
+{
+    uint64_t ticks{0};
+
+    if (::read(timer_.fd(), &ticks, sizeof(ticks)) == -1)
+    {
+        if (errno == EAGAIN)
+        {
+            return 0;
+        }
+
+        std::string what( "read timerfd " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    if (ticks > 1)
+    {
+        statistics_.missed += ticks - 1;
+    }
+
+    return ticks;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledFramePacer::send()
+{
+    hardware_.displayUpdate();
+
+    pending_ = false;
+    ++statistics_.frames;
+}
+
@@ -0,0 +1,107 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_FRAME_PACER_H
+#define OLED_FRAME_PACER_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "FileDescriptor.h"
+#include "OledHardware.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// Limits displayUpdate() to a target frame rate. Deadlines come from a
+// timerfd, which can also be added to a poll() loop through fd().
+//
+// update() asks for the display to be updated. It sends at once if a
+// deadline has passed since the last frame; otherwise the request waits
+// for the next deadline and is merged with any that follow it. wait()
+// sleeps until the next deadline and then sends any waiting request.
+
+class OledFramePacer
+{
+public:
+
+    // frames is the number of displayUpdate() calls made.
+    //
+    // coalesced is the number of update() calls that found a request
+    // already waiting for the next deadline and were merged into it
+    // without sending. A call that finds a deadline has passed sends at
+    // once and is counted as a frame, whether or not a request was
+    // waiting.
+    //
+    // missed is the number of deadlines that passed without update() or
+    // wait() reading the timer in their period: each time either reads
+    // it, every expiration after the first. It does not matter whether
+    // a request was waiting, so the same gap counts the same in both.
+
+    struct Statistics
+    {
+        uint64_t frames;
+        uint64_t coalesced;
+        uint64_t missed;
+    };
+
+    OledFramePacer(
+        OledHardware& hardware,
+        double fps);
+
+    OledFramePacer(const OledFramePacer&) = delete;
+    OledFramePacer& operator= (const OledFramePacer&) = delete;
+
+    void update();
+    void wait();
+
+    int fd() const { return timer_.fd(); }
+    const Statistics& statistics() const { return statistics_; }
+
+private:
+
+    uint64_t expirations();
+    void send();
+
+    OledHardware& hardware_;
+    FileDescriptor timer_;
+    bool pending_;
+    Statistics statistics_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,240 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <vector>
+
+#include "OledBlit.h"
+#include "OledGlyph.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// Some combinations need the glyph with its bits inverted, which is
+// built up a few rows (or pages) at a time on the stack. Glyphs too
+// wide for even one row of the buffer are inverted on the heap.
+
+void
+blitInverted(
+    const SSD1306::OledPoint& p,
+    const SSD1306::OledConstRaster& glyph,
+    SSD1306::RasterOp op,
+    SSD1306::OledPixel& pixels)
+{
+    constexpr int BufferSize{32};
+
+    uint8_t buffer[BufferSize];
+    std::vector<uint8_t> wide;
+    uint8_t* inverted = buffer;
+
+    if (glyph.stride > BufferSize)
+    {
+        wide.resize(glyph.stride);
+        inverted = wide.data();
+    }
+
+    auto rowsPerBlock = (glyph.layout == SSD1306::OledLayout::PageMajor)
+                      ? 8
+                      : 1;
+    auto blocks = (glyph.height + rowsPerBlock - 1) / rowsPerBlock;
+    auto blocksPerChunk = std::max(1, BufferSize / glyph.stride);
+
+    for (auto block = 0 ; block < blocks ; block += blocksPerChunk)
+    {
+        auto count = std::min(blocksPerChunk, blocks - block);
+        auto bytes = glyph.bytes + (block * glyph.stride);
+
+        std::transform(bytes,
+                       bytes + (count * glyph.stride),
+                       inverted,
+                       [](uint8_t byte) { return uint8_t(~byte); });
+
+        auto top = block * rowsPerBlock;
+
+        SSD1306::OledConstRaster chunk{glyph.layout,
+                                       glyph.width,
+                                       std::min(count * rowsPerBlock,
+                                                glyph.height - top),
+                                       glyph.stride,
+                                       inverted};
+
+        SSD1306::blit(chunk,
+                      SSD1306::OledPoint{p.x(), p.y() + top},
+                      op,
+                      pixels);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+blitGlyph(
+    const SSD1306::OledPoint& p,
+    const SSD1306::OledConstRaster& glyph,
+    SSD1306::RasterOp op,
+    SSD1306::OledPixel& pixels)
+{
+    SSD1306::blit(glyph, p, op, pixels);
+}
+
+//-------------------------------------------------------------------------
+
+void
+xorCell(
+    const SSD1306::OledPoint& p,
+    const SSD1306::OledConstRaster& glyph,
+    SSD1306::RasterOp,
+    SSD1306::OledPixel& pixels)
+{
+    pixels.rectangle(p,
+                     SSD1306::OledPoint{p.x() + glyph.width - 1,
+                                        p.y() + glyph.height - 1},
+                     SSD1306::PixelStyle::Xor);
+}
+
+//-------------------------------------------------------------------------
+
+void
+drawNothing(
+    const SSD1306::OledPoint&,
+    const SSD1306::OledConstRaster&,
+    SSD1306::RasterOp,
+    SSD1306::OledPixel&)
+{
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledGlyphOp::OledGlyphOp(
+    PixelStyle style,
+    GlyphMode mode)
+:
+    draw_{drawNothing},
+    op_{RasterOp::Copy},
+    drawsNothing_{false}
+{
+    if (mode == GlyphMode::Transparent)
+    {
+        switch (style)
+        {
+        case PixelStyle::Set:
+
+            draw_ = blitGlyph;
+            op_ = RasterOp::Set;
+            break;
+
+        case PixelStyle::Unset:
+
+            draw_ = blitGlyph;
+            op_ = RasterOp::Unset;
+            break;
+
+        case PixelStyle::Xor:
+
+            draw_ = blitGlyph;
+            op_ = RasterOp::Xor;
+            break;
+
+        case PixelStyle::None:
+
+            drawsNothing_ = true;
+            break;
+        }
+    }
+    else
+    {
+        // The character in style and the rest of the cell in
+        // oppositeStyle(style).
+
+        switch (style)
+        {
+        case PixelStyle::Set:
+
+            draw_ = blitGlyph;
+            op_ = RasterOp::Copy;
+            break;
+
+        case PixelStyle::Unset:
+
+            draw_ = blitInverted;
+            op_ = RasterOp::Copy;
+            break;
+
+        case PixelStyle::Xor:
+
+            draw_ = xorCell;
+            break;
+
+        case PixelStyle::None:
+
+            draw_ = blitInverted;
+            op_ = RasterOp::Xor;
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::drawGlyph(
+    const OledPoint& p,
+    const OledConstRaster& glyph,
+    PixelStyle style,
+    GlyphMode mode,
+    OledPixel& pixels)
+{
+    OledGlyphOp{style, mode}.draw(p, glyph, pixels);
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::drawGlyph(
+    const OledPoint& p,
+    const uint8_t* rows,
+    int height,
+    PixelStyle style,
+    GlyphMode mode,
+    OledPixel& pixels)
+{
+    drawGlyph(p,
+              OledConstRaster{OledLayout::RowMajor, 8, height, 1, rows},
+              style,
+              mode,
+              pixels);
+}
+
@@ -0,0 +1,191 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_GLYPH_H
+#define OLED_GLYPH_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "OledBlit.h"
+#include "OledPixel.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// How a glyph treats the pixels of its cell that are not part of the
+// character.
+//
+// Opaque - they are drawn in the opposite style, replacing whatever was
+//          there before.
+// Transparent - they are left alone.
+
+enum class GlyphMode
+{
+    Opaque,
+    Transparent
+};
+
+//-------------------------------------------------------------------------
+
+// What drawGlyph() does for one style and mode, worked out once into a
+// blit function and raster op, so that a string of glyphs is drawn
+// without looking at either again.
+
+class OledGlyphOp
+{
+public:
+
+    OledGlyphOp(PixelStyle style, GlyphMode mode);
+
+    // PixelStyle::None in GlyphMode::Transparent leaves every pixel as
+    // it is, so callers can skip the glyphs altogether.
+
+    bool drawsNothing() const { return drawsNothing_; }
+
+    void
+    draw(
+        const OledPoint& p,
+        const OledConstRaster& glyph,
+        OledPixel& pixels) const
+    {
+        if ((glyph.bytes != nullptr) &&
+            (glyph.width > 0) &&
+            (glyph.height > 0))
+        {
+            draw_(p, glyph, op_, pixels);
+        }
+    }
+
+private:
+
+    using DrawFunction = void (*)(const OledPoint& p,
+                                  const OledConstRaster& glyph,
+                                  RasterOp op,
+                                  OledPixel& pixels);
+
+    DrawFunction draw_;
+    RasterOp op_;
+    bool drawsNothing_;
+};
+
+//-------------------------------------------------------------------------
+
+// Draw a glyph held as a raster view, in either layout. The glyph is
+// blitted a byte at a time rather than a pixel at a time.
+
+void
+drawGlyph(
+    const OledPoint& p,
+    const OledConstRaster& glyph,
+    PixelStyle style,
+    GlyphMode mode,
+    OledPixel& pixels);
+
+// Draw a glyph eight pixels wide, given as one byte per row with the
+// leftmost pixel in the most significant bit.
+
+void
+drawGlyph(
+    const OledPoint& p,
+    const uint8_t* rows,
+    int height,
+    PixelStyle style,
+    GlyphMode mode,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+// A font of 256 glyphs eight pixels wide, laid out page-major like the
+// display's own memory: for each glyph, eight column bytes per page of
+// eight rows, top row in the least significant bit. Glyphs drawn on a
+// page boundary are then straight byte copies into the display.
+
+template<int HEIGHT>
+struct OledPageFont
+{
+    static constexpr int Width{8};
+    static constexpr int Height{HEIGHT};
+    static constexpr int Pages{(HEIGHT + 7) / 8};
+
+    OledConstRaster
+    glyph(
+        uint8_t c) const
+    {
+        return OledConstRaster{OledLayout::PageMajor,
+                               Width,
+                               Height,
+                               Width,
+                               glyphs[c]};
+    }
+
+    uint8_t glyphs[256][Pages * Width];
+};
+
+//-------------------------------------------------------------------------
+
+// Transpose a row-major font table into an OledPageFont at compile time.
+
+template<int HEIGHT>
+constexpr OledPageFont<HEIGHT>
+pageFont(
+    const uint8_t (&rows)[256][HEIGHT])
+{
+    OledPageFont<HEIGHT> font{};
+
+    for (auto c = 0 ; c < 256 ; ++c)
+    {
+        for (auto y = 0 ; y < HEIGHT ; ++y)
+        {
+            for (auto x = 0 ; x < OledPageFont<HEIGHT>::Width ; ++x)
+            {
+                if (rows[c][y] & (0x80 >> x))
+                {
+                    auto& byte = font.glyphs[c][((y / 8) * 8) + x];
+                    byte = static_cast<uint8_t>(byte | (1 << (y % 8)));
+                }
+            }
+        }
+    }
+
+    return font;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
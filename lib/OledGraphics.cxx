@@ -25,14 +25,380 @@
 //
 //-------------------------------------------------------------------------
 
-#include <cmath>
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
 
 #include "OledGraphics.h"
+#include "OledStaticGraphics.h"
 #include "point.h"
 
 //-------------------------------------------------------------------------
 
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+using SSD1306::detail::ellipseQuadrant;
+using SSD1306::detail::floorDiv;
+
+//-------------------------------------------------------------------------
+
+// sin() of 0 to 90 degrees, scaled by 2^14.
+
+constexpr int SineShift{14};
+
+constexpr int16_t Sine[91]
+{
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,
+     2280,  2563,  2845,  3126,  3406,  3686,  3964,  4240,
+     4516,  4790,  5063,  5334,  5604,  5872,  6138,  6402,
+     6664,  6924,  7182,  7438,  7692,  7943,  8192,  8438,
+     8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982,
+    12176, 12365, 12551, 12733, 12911, 13085, 13255, 13421,
+    13583, 13741, 13894, 14044, 14189, 14330, 14466, 14598,
+    14726, 14849, 14968, 15082, 15191, 15296, 15396, 15491,
+    15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362,
+    16374, 16382, 16384
+};
+
+//-------------------------------------------------------------------------
+
+// Each x gives the row x away from the center, whose half width is y.
+// The row y away is complete only when y is about to step, and is left
+// to the x rows once the two meet.
+
+template<typename ROW>
+void
+circleRows(
+    int radius,
+    ROW row)
+{
+    int x = 0;
+    int y = radius;
+    int64_t d = 1 - int64_t{radius};
+
+    while (x <= y)
+    {
+        row(x, y);
+
+        if (x != 0)
+        {
+            row(-x, y);
+        }
+
+        if (d < 0)
+        {
+            d += (2 * int64_t{x}) + 3;
+        }
+        else
+        {
+            if (x != y)
+            {
+                row(y, x);
+                row(-y, x);
+            }
+
+            d += (2 * (int64_t{x} - y)) + 5;
+            --y;
+        }
+
+        ++x;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+template<typename ROW>
+void
+ellipseRows(
+    int radiusX,
+    int radiusY,
+    ROW row)
+{
+    int rowY = radiusY;
+    int halfWidth = 0;
+
+    auto complete = [&row](int y, int width)
+    {
+        row(y, width);
+
+        if (y != 0)
+        {
+            row(-y, width);
+        }
+    };
+
+    ellipseQuadrant(radiusX, radiusY, [&](int x, int y)
+    {
+        if (y != rowY)
+        {
+            complete(rowY, halfWidth);
+            rowY = y;
+        }
+
+        halfWidth = x;
+    });
+
+    complete(rowY, halfWidth);
+}
+
+//-------------------------------------------------------------------------
+
+// A non-horizontal polygon edge, for scan conversion. It crosses the
+// rows from yTop up to, but not including, yBottom; counting each edge
+// that way counts a vertex once where the boundary passes through it
+// and twice or not at all where it turns back.
+//
+// Where the edge crosses the current row is tracked exactly, as x plus
+// remainder / dy.
+
+struct Edge
+{
+    int yTop;
+    int yBottom;
+    int xTop;
+    int direction;
+    int64_t dx;
+    int64_t dy;
+    int64_t x;
+    int64_t remainder;
+};
+
+//-------------------------------------------------------------------------
+
+void
+startEdge(
+    Edge& edge,
+    int y)
+{
+    auto offset = (int64_t{y} - edge.yTop) * edge.dx;
+    auto whole = floorDiv(offset, edge.dy);
+
+    edge.x = edge.xTop + whole;
+    edge.remainder = offset - (whole * edge.dy);
+}
+
+//-------------------------------------------------------------------------
+
+void
+stepEdge(
+    Edge& edge)
+{
+    auto whole = floorDiv(edge.dx, edge.dy);
+
+    edge.x += whole;
+    edge.remainder += edge.dx - (whole * edge.dy);
+
+    if (edge.remainder >= edge.dy)
+    {
+        ++edge.x;
+        edge.remainder -= edge.dy;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+leftOf(
+    const Edge& lhs,
+    const Edge& rhs)
+{
+    if (lhs.x != rhs.x)
+    {
+        return lhs.x < rhs.x;
+    }
+
+    return (lhs.remainder * rhs.dy) < (rhs.remainder * lhs.dy);
+}
+
+//-------------------------------------------------------------------------
+
+using Span = std::pair<int, int>;
+
+//-------------------------------------------------------------------------
+
+// Part of a polygon's boundary that lies on one row: a horizontal edge,
+// or the lower end of an edge, which the fill rule leaves out.
+
+struct BoundarySpan
+{
+    int y;
+    int x1;
+    int x2;
+};
+
+//-------------------------------------------------------------------------
+
+// Draw the spans of one row, merging any that touch or overlap so that
+// no pixel is drawn twice.
+
+void
+drawSpans(
+    std::vector<Span>& spans,
+    int y,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    if (spans.empty())
+    {
+        return;
+    }
+
+    std::sort(spans.begin(), spans.end());
+
+    auto span = spans.front();
+
+    for (auto& next : spans)
+    {
+        if (next.first <= (span.second + 1))
+        {
+            span.second = std::max(span.second, next.second);
+        }
+        else
+        {
+            pixels.horizontalSpan(span.first, span.second, y, style);
+            span = next;
+        }
+    }
+
+    pixels.horizontalSpan(span.first, span.second, y, style);
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+int
+SSD1306::detail::sine(
+    int angle)
+{
+    angle %= 360;
+
+    if (angle < 0)
+    {
+        angle += 360;
+    }
+
+    if (angle <= 90)
+    {
+        return Sine[angle];
+    }
+    else if (angle <= 180)
+    {
+        return Sine[180 - angle];
+    }
+    else if (angle <= 270)
+    {
+        return -Sine[angle - 180];
+    }
+
+    return -Sine[360 - angle];
+}
+
+//-------------------------------------------------------------------------
+
+int
+SSD1306::detail::cosine(
+    int angle)
+{
+    return sine((angle % 360) + 90);
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::arc(
+    const SSD1306::OledPoint& center,
+    int radius,
+    int startAngle,
+    int endAngle,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    dispatchStyle(style, [&](auto s)
+    {
+        SSD1306::arc<decltype(s)::value>(center,
+                                         radius,
+                                         startAngle,
+                                         endAngle,
+                                         pixels);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::arcFilled(
+    const SSD1306::OledPoint& center,
+    int radius,
+    int startAngle,
+    int endAngle,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    if ((style == PixelStyle::None) || (radius < 0))
+    {
+        return;
+    }
+
+    SSD1306::detail::Sweep sweep{startAngle, endAngle};
+
+    if (sweep.full())
+    {
+        circleFilled(center, radius, style, pixels);
+        return;
+    }
+
+    // Only the part of each row that is on the display is tested, and
+    // each run of pixels inside the sweep is drawn as one span.
+
+    circleRows(radius, [&](int y, int halfWidth)
+    {
+        auto row = center.y() + y;
+
+        if ((row < 0) || (row >= pixels.height()))
+        {
+            return;
+        }
+
+        auto first = std::max(center.x() - halfWidth, 0);
+        auto last = std::min(center.x() + halfWidth, pixels.width() - 1);
+        auto start = first;
+        auto inRun = false;
+
+        for (auto x = first ; x <= last ; ++x)
+        {
+            auto inside = sweep.inside(x - center.x(), y);
+
+            if (inside && (not inRun))
+            {
+                start = x;
+            }
+            else if (inRun && (not inside))
+            {
+                pixels.horizontalSpan(start, x - 1, row, style);
+            }
+
+            inRun = inside;
+        }
+
+        if (inRun)
+        {
+            pixels.horizontalSpan(start, last, row, style);
+        }
+    });
+}
+
+//-------------------------------------------------------------------------
+
 void
 SSD1306::box(
     const SSD1306::OledPoint& p1,
@@ -55,16 +421,88 @@ SSD1306::boxFilled(
     SSD1306::PixelStyle style,
     SSD1306::OledPixel& pixels)
 {
-    int sign_y = (p1.y() <= p2.y()) ? 1 : -1;
-    int y = p1.y();
+    pixels.rectangle(p1, p2, style);
+}
 
-    horizontalLine(p1.x(), p2.x(), y, style, pixels);
+//-------------------------------------------------------------------------
 
-    while (y != p2.y())
+void
+SSD1306::circle(
+    const SSD1306::OledPoint& center,
+    int radius,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    dispatchStyle(style, [&](auto s)
     {
-        y += sign_y;
-        horizontalLine(p1.x(), p2.x(), y, style, pixels);
+        SSD1306::circle<decltype(s)::value>(center, radius, pixels);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::circleFilled(
+    const SSD1306::OledPoint& center,
+    int radius,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    if ((style == PixelStyle::None) || (radius < 0))
+    {
+        return;
+    }
+
+    circleRows(radius, [&](int y, int halfWidth)
+    {
+        pixels.horizontalSpan(center.x() - halfWidth,
+                              center.x() + halfWidth,
+                              center.y() + y,
+                              style);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::ellipse(
+    const SSD1306::OledPoint& center,
+    int radiusX,
+    int radiusY,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    dispatchStyle(style, [&](auto s)
+    {
+        SSD1306::ellipse<decltype(s)::value>(center,
+                                             radiusX,
+                                             radiusY,
+                                             pixels);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::ellipseFilled(
+    const SSD1306::OledPoint& center,
+    int radiusX,
+    int radiusY,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    if ((style == PixelStyle::None) || (radiusX < 0) || (radiusY < 0))
+    {
+        return;
     }
+
+    ellipseRows(radiusX, radiusY, [&](int y, int halfWidth)
+    {
+        pixels.horizontalSpan(center.x() - halfWidth,
+                              center.x() + halfWidth,
+                              center.y() + y,
+                              style);
+    });
 }
 
 //-------------------------------------------------------------------------
@@ -76,96 +514,240 @@ SSD1306::line(
     SSD1306::PixelStyle style,
     SSD1306::OledPixel& pixels)
 {
-    if (p1.y() == p2.y())
+    dispatchStyle(style, [&](auto s)
     {
-        horizontalLine(p1.x(), p2.x(), p1.y(), style, pixels);
-    }
-    else if (p1.x() == p2.x())
+        SSD1306::line<decltype(s)::value>(p1, p2, pixels);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::horizontalLine(
+    int x1,
+    int x2,
+    int y,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    pixels.horizontalSpan(x1, x2, y, style);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledPoint
+SSD1306::polarPoint(
+    const SSD1306::OledPoint& center,
+    int radius,
+    int angle)
+{
+    constexpr int64_t half = int64_t{1} << (SineShift - 1);
+    constexpr int64_t one = int64_t{1} << SineShift;
+
+    return SSD1306::OledPoint{
+        center.x() + static_cast<int>(floorDiv((int64_t{radius}
+                                                * detail::cosine(angle))
+                                               + half,
+                                               one)),
+        center.y() + static_cast<int>(floorDiv((int64_t{radius}
+                                                * detail::sine(angle))
+                                               + half,
+                                               one))};
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::polygon(
+    const SSD1306::OledPoint* points,
+    int count,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    dispatchStyle(style, [&](auto s)
     {
-        verticalLine(p1.x(), p1.y(), p2.y(), style, pixels);
+        SSD1306::polygon<decltype(s)::value>(points, count, pixels);
+    });
+}
+
+//-------------------------------------------------------------------------
+
+// Scan convert a polygon with an edge table, sorted by first row, and an
+// active edge list, kept sorted by where each edge crosses the row. The
+// pixels filled are those whose centers lie inside the polygon or on
+// its boundary.
+
+void
+SSD1306::polygonFilled(
+    const SSD1306::OledPoint* points,
+    int count,
+    SSD1306::FillRule rule,
+    SSD1306::PixelStyle style,
+    SSD1306::OledPixel& pixels)
+{
+    if ((style == PixelStyle::None) || (points == nullptr) || (count < 1))
+    {
+        return;
     }
-    else
+
+    std::vector<Edge> edges;
+    std::vector<BoundarySpan> boundary;
+
+    auto yMin = points[0].y();
+    auto yMax = points[0].y();
+
+    for (auto i = 0 ; i < count ; ++i)
     {
-        int dx = std::abs(p2.x() - p1.x());
-        int dy = std::abs(p2.y() - p1.y());
+        auto& p1 = points[i];
+        auto& p2 = points[(i + 1) % count];
 
-        int sign_x = (p1.x() <= p2.x()) ? 1 : -1;
-        int sign_y = (p1.y() <= p2.y()) ? 1 : -1;
+        yMin = std::min(yMin, p1.y());
+        yMax = std::max(yMax, p1.y());
 
-        int x = p1.x();
-        int y = p1.y();
+        if (p1.y() == p2.y())
+        {
+            boundary.push_back({p1.y(),
+                                std::min(p1.x(), p2.x()),
+                                std::max(p1.x(), p2.x())});
+            continue;
+        }
 
-        pixels.pixel(p1, style);
+        auto& top = (p1.y() < p2.y()) ? p1 : p2;
+        auto& bottom = (p1.y() < p2.y()) ? p2 : p1;
+
+        Edge edge;
+        edge.yTop = top.y();
+        edge.yBottom = bottom.y();
+        edge.xTop = top.x();
+        edge.direction = (p1.y() < p2.y()) ? 1 : -1;
+        edge.dx = int64_t{bottom.x()} - top.x();
+        edge.dy = int64_t{bottom.y()} - top.y();
+        edge.x = 0;
+        edge.remainder = 0;
+
+        edges.push_back(edge);
+        boundary.push_back({bottom.y(), bottom.x(), bottom.x()});
+    }
+
+    std::sort(edges.begin(),
+              edges.end(),
+              [](const Edge& lhs, const Edge& rhs)
+              {
+                  return lhs.yTop < rhs.yTop;
+              });
+
+    std::sort(boundary.begin(),
+              boundary.end(),
+              [](const BoundarySpan& lhs, const BoundarySpan& rhs)
+              {
+                  return lhs.y < rhs.y;
+              });
+
+    auto first = std::max(yMin, 0);
+    auto last = std::min(yMax, pixels.height() - 1);
+
+    std::vector<Edge> active;
+    std::vector<Span> spans;
+    auto next = edges.begin();
+    auto nextBoundary = boundary.begin();
+
+    for (auto y = first ; y <= last ; ++y)
+    {
+        // Drop the edges that end above this row, step the rest down to
+        // it and add the edges that start on or above it.
 
-        if (dx > dy)
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [y](const Edge& edge)
+                                    {
+                                        return edge.yBottom <= y;
+                                    }),
+                     active.end());
+
+        for (auto& edge : active)
         {
-            int d = 2 * dy - dx;
-            int incrE = 2 * dy;
-            int incrNE = 2 * (dy - dx);
+            stepEdge(edge);
+        }
 
-            while (x != p2.x())
+        for ( ; (next != edges.end()) && (next->yTop <= y) ; ++next)
+        {
+            if (next->yBottom > y)
             {
-                x += sign_x;
+                active.push_back(*next);
+                startEdge(active.back(), y);
+            }
+        }
 
-                if (d <= 0)
-                {
-                    d += incrE;
-                }
-                else
-                {
-                    d += incrNE;
-                    y += sign_y;
-                }
+        // The edges stay nearly in order from row to row, which suits
+        // an insertion sort.
 
-                pixels.pixel(SSD1306::OledPoint{x, y}, style);
+        for (auto i = 1 ; i < static_cast<int>(active.size()) ; ++i)
+        {
+            for (auto j = i ;
+                 (j > 0) && leftOf(active[j], active[j - 1]) ;
+                 --j)
+            {
+                std::swap(active[j], active[j - 1]);
             }
         }
-        else
+
+        spans.clear();
+
+        auto winding = 0;
+
+        for (auto i = 0 ; (i + 1) < static_cast<int>(active.size()) ; ++i)
         {
-            int d = 2 * dx - dy;
-            int incrN = 2 * dx;
-            int incrNE = 2 * (dx - dy);
+            winding += active[i].direction;
 
-            while (y != p2.y())
+            auto inside = (rule == SSD1306::FillRule::EvenOdd)
+                        ? ((i % 2) == 0)
+                        : (winding != 0);
+
+            if (inside)
             {
-                y += sign_y;
+                auto& left = active[i];
+                auto& right = active[i + 1];
 
-                if (d <= 0)
-                {
-                    d += incrN;
-                }
-                else
+                auto start = static_cast<int>(left.x)
+                           + ((left.remainder > 0) ? 1 : 0);
+                auto end = static_cast<int>(right.x);
+
+                if (start <= end)
                 {
-                    d += incrNE;
-                    x += sign_x;
+                    spans.emplace_back(start, end);
                 }
+            }
+        }
+
+        // The boundary itself, skipping any above the display.
 
-                pixels.pixel(SSD1306::OledPoint{x, y}, style);
+        for ( ;
+             (nextBoundary != boundary.end()) && (nextBoundary->y <= y) ;
+             ++nextBoundary)
+        {
+            if (nextBoundary->y == y)
+            {
+                spans.emplace_back(nextBoundary->x1, nextBoundary->x2);
             }
         }
+
+        drawSpans(spans, y, style, pixels);
     }
 }
 
 //-------------------------------------------------------------------------
 
 void
-SSD1306::horizontalLine(
-    int x1,
-    int x2,
-    int y,
+SSD1306::triangleFilled(
+    const SSD1306::OledPoint& p1,
+    const SSD1306::OledPoint& p2,
+    const SSD1306::OledPoint& p3,
     SSD1306::PixelStyle style,
     SSD1306::OledPixel& pixels)
 {
-    int sign_x = (x1 <= x2) ? 1 : -1;
-    int x = x1;
-
-    pixels.pixel(SSD1306::OledPoint{x, y}, style);
+    const SSD1306::OledPoint points[]{p1, p2, p3};
 
-    while (x != x2)
-    {
-        x += sign_x;
-        pixels.pixel(SSD1306::OledPoint{x, y}, style);
-    }
+    polygonFilled(points, 3, FillRule::EvenOdd, style, pixels);
 }
 
 //-------------------------------------------------------------------------
@@ -178,15 +760,6 @@ SSD1306::verticalLine(
     SSD1306::PixelStyle style,
     SSD1306::OledPixel& pixels)
 {
-    int sign_y = (y1 <= y2) ? 1 : -1;
-    int y = y1;
-
-    pixels.pixel(SSD1306::OledPoint{x, y}, style);
-
-    while (y != y2)
-    {
-        y += sign_y;
-        pixels.pixel(SSD1306::OledPoint{x, y}, style);
-    }
+    pixels.verticalSpan(x, y1, y2, style);
 }
 
@@ -42,6 +42,46 @@ namespace SSD1306
 
 //-------------------------------------------------------------------------
 
+// Which parts of a self-intersecting polygon polygonFilled() treats as
+// inside. EvenOdd - those inside an odd number of times. NonZero - those
+// the outline winds around at all.
+
+enum class FillRule
+{
+    EvenOdd,
+    NonZero
+};
+
+//-------------------------------------------------------------------------
+
+// Angles are in whole degrees, with 0 pointing right and angles
+// increasing clockwise on the display (the y axis points down). Arcs are
+// drawn clockwise from startAngle to endAngle; a sweep of 360 degrees or
+// more draws the whole circle. arcFilled() draws the sector, including
+// the center.
+
+void
+arc(
+    const OledPoint& center,
+    int radius,
+    int startAngle,
+    int endAngle,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+void
+arcFilled(
+    const OledPoint& center,
+    int radius,
+    int startAngle,
+    int endAngle,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
 void
 box(
     const OledPoint& p1,
@@ -60,6 +100,44 @@ boxFilled(
 
 //-------------------------------------------------------------------------
 
+void
+circle(
+    const OledPoint& center,
+    int radius,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+void
+circleFilled(
+    const OledPoint& center,
+    int radius,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+void
+ellipse(
+    const OledPoint& center,
+    int radiusX,
+    int radiusY,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+void
+ellipseFilled(
+    const OledPoint& center,
+    int radiusX,
+    int radiusY,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
 void
 line(
     const OledPoint& p1,
@@ -79,6 +157,49 @@ horizontalLine(
 
 //-------------------------------------------------------------------------
 
+// The point at distance radius from center, in the direction angle, using
+// the same integer sine table as the arcs.
+
+OledPoint
+polarPoint(
+    const OledPoint& center,
+    int radius,
+    int angle);
+
+//-------------------------------------------------------------------------
+
+// A closed polygon through count points. The outline draws each pixel
+// where one edge meets the next once only.
+
+void
+polygon(
+    const OledPoint* points,
+    int count,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+void
+polygonFilled(
+    const OledPoint* points,
+    int count,
+    FillRule rule,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
+void
+triangleFilled(
+    const OledPoint& p1,
+    const OledPoint& p2,
+    const OledPoint& p3,
+    PixelStyle style,
+    OledPixel& pixels);
+
+//-------------------------------------------------------------------------
+
 void
 verticalLine(
     int x,
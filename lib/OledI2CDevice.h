@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_I2C_DEVICE_H
+#define OLED_I2C_DEVICE_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// One I2C write to the display, including its leading control byte.
+
+struct OledI2CMessage
+{
+    const uint8_t* bytes;
+    int length;
+};
+
+using OledI2CMessages = std::vector<OledI2CMessage>;
+
+//------------------------------------------------------------------------
+
+class OledI2CDevice
+{
+public:
+
+    virtual ~OledI2CDevice() = 0;
+
+    // Write the messages to the display in order, as a single combined
+    // transfer where the bus allows it.
+
+    virtual void transfer(const OledI2CMessages& messages) = 0;
+
+    // The number of system calls made so far by transfer(), for devices
+    // that talk to the kernel. Others return zero.
+
+    virtual uint64_t syscalls() const;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,75 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_I2C_FAKE_DEVICE_H
+#define OLED_I2C_FAKE_DEVICE_H
+
+//------------------------------------------------------------------------
+
+#include <functional>
+
+#include "OledI2CDevice.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+using TransferFunction = std::function<void(const OledI2CMessages&)>;
+
+//------------------------------------------------------------------------
+
+// A device that hands every transfer to a function instead of a bus, so
+// that OledI2C can be driven and inspected without hardware.
+
+class OledI2CFakeDevice
+:
+    public OledI2CDevice
+{
+public:
+
+    explicit OledI2CFakeDevice(
+        TransferFunction on_transfer = [](const OledI2CMessages&) {});
+
+    ~OledI2CFakeDevice() override;
+
+    void transfer(const OledI2CMessages& messages) override;
+
+private:
+
+    TransferFunction on_transfer_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,164 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include <sys/ioctl.h>
+
+#include <algorithm>
+#include <system_error>
+
+#include "OledI2CLinuxDevice.h"
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CLinuxDevice::OledI2CLinuxDevice(
+    const std::string& device,
+    uint8_t address)
+:
+    fd_{-1},
+    address_{address},
+    combined_{false},
+    syscalls_{0}
+{
+    fd_ = FileDescriptor{::open(device.c_str(), O_RDWR)};
+
+    if (fd_.fd() == -1)
+    {
+        std::string what( "open "
+                        + device
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    if (ioctl(fd_.fd(), I2C_SLAVE, address) == -1)
+    {
+        std::string what( "ioctl I2C_SLAVE " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    unsigned long funcs{0};
+
+    if (ioctl(fd_.fd(), I2C_FUNCS, &funcs) != -1)
+    {
+        combined_ = (funcs & I2C_FUNC_I2C) != 0;
+    }
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CLinuxDevice::~OledI2CLinuxDevice() = default;
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledI2CLinuxDevice::transfer(
+    const OledI2CMessages& messages)
+{
+    if (combined_)
+    {
+        readWrite(messages);
+    }
+    else
+    {
+        write(messages);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledI2CLinuxDevice::readWrite(
+    const OledI2CMessages& messages)
+{
+    std::vector<i2c_msg> msgs;
+    msgs.reserve(messages.size());
+
+    for (const auto& message : messages)
+    {
+        i2c_msg msg;
+
+        msg.addr = address_;
+        msg.flags = 0;
+        msg.len = message.length;
+        msg.buf = const_cast<uint8_t*>(message.bytes);
+
+        msgs.push_back(msg);
+    }
+
+    // The kernel limits the number of messages in one ioctl.
+
+    for (std::size_t first = 0 ; first < msgs.size() ; )
+    {
+        auto count = std::min(msgs.size() - first,
+                              std::size_t{I2C_RDWR_IOCTL_MAX_MSGS});
+
+        i2c_rdwr_ioctl_data data;
+
+        data.msgs = msgs.data() + first;
+        data.nmsgs = count;
+
+        ++syscalls_;
+
+        if (ioctl(fd_.fd(), I2C_RDWR, &data) == -1)
+        {
+            std::string what( "ioctl I2C_RDWR " __FILE__ "("
+                            + std::to_string(__LINE__)
+                            + ")" );
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        first += count;
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledI2CLinuxDevice::write(
+    const OledI2CMessages& messages)
+{
+    for (const auto& message : messages)
+    {
+        ++syscalls_;
+
+        if (::write(fd_.fd(), message.bytes, message.length) == -1)
+        {
+            std::string what( "write " __FILE__ "("
+                            + std::to_string(__LINE__)
+                            + ")" );
+            throw std::system_error(errno, std::system_category(), what);
+        }
+    }
+}
+
@@ -0,0 +1,88 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_I2C_LINUX_DEVICE_H
+#define OLED_I2C_LINUX_DEVICE_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+
+#include "FileDescriptor.h"
+#include "OledI2CDevice.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// A display on a Linux /dev/i2c-N bus. When the adapter supports plain
+// I2C transfers, all messages of a transfer are sent by one I2C_RDWR
+// ioctl, joined by repeated starts so that no other bus master can come
+// between them. SMBus-only adapters fall back to one write per message.
+
+class OledI2CLinuxDevice
+:
+    public OledI2CDevice
+{
+public:
+
+    OledI2CLinuxDevice(
+        const std::string& device,
+        uint8_t address);
+
+    ~OledI2CLinuxDevice() override;
+
+    OledI2CLinuxDevice(const OledI2CLinuxDevice&) = delete;
+    OledI2CLinuxDevice& operator= (const OledI2CLinuxDevice&) = delete;
+
+    bool combined() const { return combined_; }
+
+    void transfer(const OledI2CMessages& messages) override;
+    uint64_t syscalls() const override { return syscalls_; }
+
+private:
+
+    void readWrite(const OledI2CMessages& messages);
+    void write(const OledI2CMessages& messages);
+
+    FileDescriptor fd_;
+    uint8_t address_;
+    bool combined_;
+    uint64_t syscalls_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
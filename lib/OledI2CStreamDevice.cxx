@@ -0,0 +1,133 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <system_error>
+
+#include "OledI2CStreamDevice.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+    void
+    append16(
+        std::vector<uint8_t>& buffer,
+        int value)
+    {
+        buffer.push_back(value & 0xFF);
+        buffer.push_back((value >> 8) & 0xFF);
+    }
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CStreamDevice::OledI2CStreamDevice(
+    const std::string& path)
+:
+    fd_{-1},
+    buffer_{},
+    syscalls_{0}
+{
+    fd_ = FileDescriptor{::open(path.c_str(),
+                                O_WRONLY | O_CREAT | O_TRUNC,
+                                0666)};
+
+    if (fd_.fd() == -1)
+    {
+        std::string what( "open "
+                        + path
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CStreamDevice::~OledI2CStreamDevice() = default;
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledI2CStreamDevice::transfer(
+    const OledI2CMessages& messages)
+{
+    if (messages.size() > 0xFFFF)
+    {
+        throw std::invalid_argument("too many messages in one transfer");
+    }
+
+    buffer_.clear();
+    append16(buffer_, messages.size());
+
+    for (const auto& message : messages)
+    {
+        if ((message.length < 0) || (message.length > 0xFFFF))
+        {
+            throw std::invalid_argument("I2C message length out of range");
+        }
+
+        append16(buffer_, message.length);
+        buffer_.insert(buffer_.end(),
+                       message.bytes,
+                       message.bytes + message.length);
+    }
+
+    // Write the whole transfer, so that a reader never sees part of one.
+
+    auto bytes = buffer_.data();
+    auto remaining = buffer_.size();
+
+    while (remaining > 0)
+    {
+        ++syscalls_;
+        auto written = ::write(fd_.fd(), bytes, remaining);
+
+        if (written == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            std::string what( "write " __FILE__ "("
+                            + std::to_string(__LINE__)
+                            + ")" );
+            throw std::system_error(errno, std::system_category(), what);
+        }
+
+        bytes += written;
+        remaining -= written;
+    }
+}
+
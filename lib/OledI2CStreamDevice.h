@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_I2C_STREAM_DEVICE_H
+#define OLED_I2C_STREAM_DEVICE_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "FileDescriptor.h"
+#include "OledI2CDevice.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// A device that writes every transfer to a file or named pipe instead of
+// a bus, for a display emulator running in another process (see
+// tools/oledemulator.cxx). Opening a named pipe blocks until the reader
+// has it open too.
+//
+// Each transfer is written as a little endian 16 bit message count,
+// followed by each message as a little endian 16 bit length and then its
+// bytes, including the leading control byte.
+
+class OledI2CStreamDevice
+:
+    public OledI2CDevice
+{
+public:
+
+    explicit OledI2CStreamDevice(const std::string& path);
+
+    ~OledI2CStreamDevice() override;
+
+    OledI2CStreamDevice(const OledI2CStreamDevice&) = delete;
+    OledI2CStreamDevice& operator= (const OledI2CStreamDevice&) = delete;
+
+    void transfer(const OledI2CMessages& messages) override;
+    uint64_t syscalls() const override { return syscalls_; }
+
+private:
+
+    FileDescriptor fd_;
+    std::vector<uint8_t> buffer_;
+    uint64_t syscalls_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,97 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include "OledI2CLinuxDevice.h"
+#include "OledI2CTransport.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+    constexpr uint8_t OLED_COMMAND{0x00};
+    constexpr uint8_t OLED_DATA{0x40};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CTransport::OledI2CTransport(
+    const std::string& device,
+    uint8_t address)
+:
+    OledI2CTransport{std::make_unique<OledI2CLinuxDevice>(device, address)}
+{
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CTransport::OledI2CTransport(
+    std::unique_ptr<OledI2CDevice> device)
+:
+    device_{std::move(device)}
+{
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledI2CTransport::~OledI2CTransport() = default;
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledI2CTransport::send(
+    const OledTransaction& transaction)
+{
+    const auto& segments = transaction.segments();
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(segments.size() + transaction.size());
+
+    OledI2CMessages messages;
+    messages.reserve(segments.size());
+
+    for (const auto& segment : segments)
+    {
+        bytes.push_back((segment.type == OledTransaction::Type::Command)
+                        ? OLED_COMMAND
+                        : OLED_DATA);
+
+        auto data = transaction.data(segment);
+        bytes.insert(bytes.end(), data, data + segment.length);
+    }
+
+    auto offset = 0;
+
+    for (const auto& segment : segments)
+    {
+        messages.push_back(OledI2CMessage{bytes.data() + offset,
+                                          1 + segment.length});
+        offset += 1 + segment.length;
+    }
+
+    device_->transfer(messages);
+}
+
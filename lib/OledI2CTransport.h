@@ -0,0 +1,78 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_I2C_TRANSPORT_H
+#define OLED_I2C_TRANSPORT_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "OledI2CDevice.h"
+#include "OledTransport.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// Sends each segment of a transaction as one I2C message, led by the
+// SSD1306 command or data control byte.
+
+class OledI2CTransport
+:
+    public OledTransport
+{
+public:
+
+    OledI2CTransport(
+        const std::string& device,
+        uint8_t address);
+
+    explicit OledI2CTransport(std::unique_ptr<OledI2CDevice> device);
+
+    ~OledI2CTransport() override;
+
+    void send(const OledTransaction& transaction) override;
+    uint64_t syscalls() const override { return device_->syscalls(); }
+
+private:
+
+    std::unique_ptr<OledI2CDevice> device_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,128 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include "OledMeteredTransport.h"
+
+//------------------------------------------------------------------------
+
+SSD1306::OledTransportStats&
+SSD1306::OledTransportStats::operator+= (
+    const OledTransportStats& rhs)
+{
+    transactions += rhs.transactions;
+    segments += rhs.segments;
+    commandBytes += rhs.commandBytes;
+    dataBytes += rhs.dataBytes;
+    wireBytes += rhs.wireBytes;
+    syscalls += rhs.syscalls;
+    busTime += rhs.busTime;
+
+    return *this;
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledMeteredTransport::OledMeteredTransport(
+    std::unique_ptr<OledTransport> transport,
+    const OledBusModel& model,
+    FrameFunction on_frame)
+:
+    transport_{std::move(transport)},
+    model_{model},
+    on_frame_{on_frame},
+    statsMutex_{},
+    stats_{}
+{
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledMeteredTransport::~OledMeteredTransport() = default;
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledMeteredTransport::send(
+    const OledTransaction& transaction)
+{
+    OledTransportStats frame;
+
+    frame.transactions = 1;
+    frame.segments = transaction.segments().size();
+
+    for (const auto& segment : transaction.segments())
+    {
+        switch (segment.type)
+        {
+        case OledTransaction::Type::Command:
+
+            frame.commandBytes += segment.length;
+            break;
+
+        case OledTransaction::Type::Data:
+
+            frame.dataBytes += segment.length;
+            break;
+        }
+    }
+
+    frame.wireBytes = model_.wireBytes(transaction);
+    frame.busTime = model_.time(transaction);
+
+    auto before = transport_->syscalls();
+    transport_->send(transaction);
+    frame.syscalls = transport_->syscalls() - before;
+
+    {
+        std::lock_guard<std::mutex> lock{statsMutex_};
+        stats_ += frame;
+    }
+
+    on_frame_(frame);
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledTransportStats
+SSD1306::OledMeteredTransport::stats() const
+{
+    std::lock_guard<std::mutex> lock{statsMutex_};
+
+    return stats_;
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledMeteredTransport::resetStats()
+{
+    std::lock_guard<std::mutex> lock{statsMutex_};
+
+    stats_ = OledTransportStats{};
+}
+
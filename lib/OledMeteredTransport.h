@@ -0,0 +1,121 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_METERED_TRANSPORT_H
+#define OLED_METERED_TRANSPORT_H
+
+//------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "OledBusModel.h"
+#include "OledTransport.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// What one or more transactions cost. commandBytes and dataBytes are the
+// payload; wireBytes and busTime also count what the bus adds (see
+// OledBusModel).
+
+struct OledTransportStats
+{
+    uint64_t transactions{0};
+    uint64_t segments{0};
+    uint64_t commandBytes{0};
+    uint64_t dataBytes{0};
+    uint64_t wireBytes{0};
+    uint64_t syscalls{0};
+    std::chrono::nanoseconds busTime{0};
+
+    OledTransportStats& operator+= (const OledTransportStats& rhs);
+};
+
+using FrameFunction = std::function<void(const OledTransportStats&)>;
+
+//------------------------------------------------------------------------
+
+// A transport that sends through another and accounts for everything it
+// sends. on_frame is called after each transaction with what it cost;
+// stats() returns the running total. Each displayUpdate() is one
+// transaction.
+//
+//     auto metered = new OledMeteredTransport{
+//                        std::make_unique<OledI2CTransport>(device, 0x3C),
+//                        OledBusModel::i2c(OledBusModel::I2CFastMode)};
+//     OledDisplay oled{std::unique_ptr<OledTransport>(metered)};
+//
+// on_frame runs on the thread that sends, which is the flush thread for
+// OledDisplay::submit().
+
+class OledMeteredTransport
+:
+    public OledTransport
+{
+public:
+
+    OledMeteredTransport(
+        std::unique_ptr<OledTransport> transport,
+        const OledBusModel& model,
+        FrameFunction on_frame = [](const OledTransportStats&) {});
+
+    ~OledMeteredTransport() override;
+
+    void send(const OledTransaction& transaction) override;
+    uint64_t syscalls() const override { return transport_->syscalls(); }
+
+    const OledBusModel& model() const { return model_; }
+
+    OledTransportStats stats() const;
+    void resetStats();
+
+private:
+
+    std::unique_ptr<OledTransport> transport_;
+    OledBusModel model_;
+    FrameFunction on_frame_;
+
+    mutable std::mutex statsMutex_;
+    OledTransportStats stats_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
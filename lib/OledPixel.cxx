@@ -28,7 +28,130 @@
 #include <algorithm>
 #include <iostream>
 
+#include "OledBlit.h"
 #include "OledPixel.h"
+#include "OledPlotter.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+
+//------------------------------------------------------------------------
+
+// The fills take the style as a template parameter, so that choosing
+// what to do with each byte costs nothing inside the loops.
+
+template<SSD1306::PixelStyle STYLE>
+void
+fillPages(
+    const SSD1306::OledRaster& raster,
+    int xStart,
+    int xEnd,
+    int yStart,
+    int yEnd,
+    SSD1306::OledPixel& pixels)
+{
+    for (auto page = yStart / 8 ; (page * 8) <= yEnd ; ++page)
+    {
+        auto top = std::max(yStart, page * 8);
+        auto bottom = std::min(yEnd, (page * 8) + 7);
+
+        uint8_t mask = ((1 << (bottom - top + 1)) - 1) << (top - (page * 8));
+
+        auto row = raster.bytes + (page * raster.stride);
+        auto first = xEnd + 1;
+        auto last = xStart - 1;
+
+        for (auto x = xStart ; x <= xEnd ; ++x)
+        {
+            auto byte = SSD1306::applyStyle<STYLE>(row[x], mask);
+
+            if (byte != row[x])
+            {
+                row[x] = byte;
+                first = std::min(first, x);
+                last = x;
+            }
+        }
+
+        if (first <= last)
+        {
+            pixels.rasterChanged(SSD1306::OledPoint{first, top},
+                                 SSD1306::OledPoint{last, bottom});
+        }
+    }
+}
+
+//------------------------------------------------------------------------
+
+template<SSD1306::PixelStyle STYLE>
+void
+fillRows(
+    const SSD1306::OledRaster& raster,
+    int xStart,
+    int xEnd,
+    int yStart,
+    int yEnd,
+    SSD1306::OledPixel& pixels)
+{
+    auto firstByte = xStart / 8;
+    auto lastByte = xEnd / 8;
+
+    uint8_t leftMask = 0xFF >> (xStart % 8);
+    uint8_t rightMask = 0xFF << (7 - (xEnd % 8));
+
+    for (auto y = yStart ; y <= yEnd ; ++y)
+    {
+        auto row = raster.bytes + (y * raster.stride);
+
+        if (firstByte == lastByte)
+        {
+            row[firstByte] = SSD1306::applyStyle<STYLE>(row[firstByte],
+                                                        leftMask & rightMask);
+            continue;
+        }
+
+        row[firstByte] = SSD1306::applyStyle<STYLE>(row[firstByte], leftMask);
+        row[lastByte] = SSD1306::applyStyle<STYLE>(row[lastByte], rightMask);
+
+        auto begin = row + firstByte + 1;
+        auto end = row + lastByte;
+
+        switch (STYLE)
+        {
+        case SSD1306::PixelStyle::Set:
+
+            std::fill(begin, end, 0xFF);
+            break;
+
+        case SSD1306::PixelStyle::Unset:
+
+            std::fill(begin, end, 0x00);
+            break;
+
+        case SSD1306::PixelStyle::Xor:
+
+            for (auto byte = begin ; byte != end ; ++byte)
+            {
+                *byte ^= 0xFF;
+            }
+
+            break;
+
+        case SSD1306::PixelStyle::None:
+
+            break;
+        }
+    }
+
+    pixels.rasterChanged(SSD1306::OledPoint{xStart, yStart},
+                         SSD1306::OledPoint{xEnd, yEnd});
+}
+
+//------------------------------------------------------------------------
+
+} // namespace
 
 //------------------------------------------------------------------------
 
@@ -117,27 +240,125 @@ SSD1306::OledPixel::setFrom(
     const OledPixel& pixels,
     SSD1306::OledPoint offset)
 {
-    auto xStart = std::max(0, offset.x());
-    auto xEnd = std::min(width(), pixels.width() + offset.x());
-    auto yStart = std::max(0, offset.y());
-    auto yEnd = std::min(height(), pixels.height() + offset.y());
+    blit(pixels, offset, RasterOp::Copy, *this);
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledRaster
+SSD1306::OledPixel::raster()
+{
+    return OledRaster{OledLayout::RowMajor, width(), height(), 0, nullptr};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledConstRaster
+SSD1306::OledPixel::raster() const
+{
+    return OledConstRaster{OledLayout::RowMajor,
+                           width(),
+                           height(),
+                           0,
+                           nullptr};
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledPixel::rasterChanged(
+    SSD1306::OledPoint,
+    SSD1306::OledPoint)
+{
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledPixel::horizontalSpan(
+    int x1,
+    int x2,
+    int y,
+    SSD1306::PixelStyle style)
+{
+    rectangle(OledPoint{x1, y}, OledPoint{x2, y}, style);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledPixel::verticalSpan(
+    int x,
+    int y1,
+    int y2,
+    SSD1306::PixelStyle style)
+{
+    rectangle(OledPoint{x, y1}, OledPoint{x, y2}, style);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledPixel::rectangle(
+    SSD1306::OledPoint p1,
+    SSD1306::OledPoint p2,
+    SSD1306::PixelStyle style)
+{
+    if (style == PixelStyle::None)
+    {
+        return;
+    }
+
+    auto xStart = std::max(0, std::min(p1.x(), p2.x()));
+    auto xEnd = std::min(width() - 1, std::max(p1.x(), p2.x()));
+    auto yStart = std::max(0, std::min(p1.y(), p2.y()));
+    auto yEnd = std::min(height() - 1, std::max(p1.y(), p2.y()));
 
-    for (auto y = yStart ; y < yEnd ; ++y)
+    if ((xStart > xEnd) || (yStart > yEnd))
     {
-        for (auto x = xStart ; x < xEnd ; ++x)
+        return;
+    }
+
+    auto pixels = raster();
+
+    if (pixels.bytes == nullptr)
+    {
+        dispatchStyle(style, [&](auto s)
         {
-            OledPoint inputP{x - offset.x(), y - offset.y()};
-            OledPoint outputP{x, y};
+            OledPixelPlotter<decltype(s)::value> plot{*this};
 
-            if (pixels.isSetPixel(inputP))
+            for (auto y = yStart ; y <= yEnd ; ++y)
             {
-                setPixel(outputP);
+                for (auto x = xStart ; x <= xEnd ; ++x)
+                {
+                    plot(x, y);
+                }
             }
-            else
-            {
-                unsetPixel(outputP);
-            }
-        }
+        });
+    }
+    else if (pixels.layout == OledLayout::PageMajor)
+    {
+        dispatchStyle(style, [&](auto s)
+        {
+            fillPages<decltype(s)::value>(pixels,
+                                          xStart,
+                                          xEnd,
+                                          yStart,
+                                          yEnd,
+                                          *this);
+        });
+    }
+    else
+    {
+        dispatchStyle(style, [&](auto s)
+        {
+            fillRows<decltype(s)::value>(pixels,
+                                         xStart,
+                                         xEnd,
+                                         yStart,
+                                         yEnd,
+                                         *this);
+        });
     }
 }
 
@@ -56,6 +56,40 @@ PixelStyle oppositeStyle(PixelStyle style);
 
 //------------------------------------------------------------------------
 
+// How a pixel container arranges its bytes.
+//
+// RowMajor - each row is a run of bytes, with the leftmost pixel in the
+//            most significant bit.
+// PageMajor - the SSD1306 GDDRAM order. Each byte holds eight rows of
+//             one column, with the top row in the least significant bit,
+//             and each page of eight rows is a run of bytes.
+
+enum class OledLayout
+{
+    RowMajor,
+    PageMajor
+};
+
+//------------------------------------------------------------------------
+
+// Direct access to the bytes of a pixel container. stride is the number
+// of bytes from one row (RowMajor) or page (PageMajor) to the next.
+
+template<typename BYTE>
+struct OledRasterView
+{
+    OledLayout layout;
+    int width;
+    int height;
+    int stride;
+    BYTE* bytes;
+};
+
+using OledRaster = OledRasterView<uint8_t>;
+using OledConstRaster = OledRasterView<const uint8_t>;
+
+//------------------------------------------------------------------------
+
 class OledPixel
 {
 public:
@@ -75,8 +109,33 @@ public:
     void setFrom(const OledPixel& pixels,
                  SSD1306::OledPoint offset = {0,0});
 
+    // Runs of pixels, corners inclusive and in either order, clipped to
+    // the container. Containers with a raster() fill them a byte at a
+    // time; others a pixel at a time.
+
+    virtual void horizontalSpan(int x1,
+                                int x2,
+                                int y,
+                                SSD1306::PixelStyle style);
+    virtual void verticalSpan(int x,
+                              int y1,
+                              int y2,
+                              SSD1306::PixelStyle style);
+    virtual void rectangle(SSD1306::OledPoint p1,
+                           SSD1306::OledPoint p2,
+                           SSD1306::PixelStyle style);
+
     virtual int width() const = 0;
     virtual int height() const = 0;
+
+    // Containers that hold their pixels in memory return a view of the
+    // bytes; others return a view whose bytes are nullptr. Anything that
+    // writes through the view must then call rasterChanged() with the
+    // top left and bottom right corners of the area it changed.
+
+    virtual OledRaster raster();
+    virtual OledConstRaster raster() const;
+    virtual void rasterChanged(SSD1306::OledPoint p1, SSD1306::OledPoint p2);
 };
 
 //------------------------------------------------------------------------
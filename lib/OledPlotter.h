@@ -0,0 +1,317 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_PLOTTER_H
+#define OLED_PLOTTER_H
+
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "OledPixel.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// Plotters draw single pixels in a style fixed at compile time, so that
+// a drawing loop templated on the plotter inlines each pixel down to a
+// few instructions. Each is called as plot(x, y), which clips to
+// width() and height().
+
+//-------------------------------------------------------------------------
+
+template<PixelStyle STYLE>
+inline uint8_t
+applyStyle(
+    uint8_t byte,
+    uint8_t mask)
+{
+    switch (STYLE)
+    {
+    case PixelStyle::Set:
+
+        return byte | mask;
+
+    case PixelStyle::Unset:
+
+        return byte & ~mask;
+
+    case PixelStyle::Xor:
+
+        return byte ^ mask;
+
+    case PixelStyle::None:
+
+        return byte;
+    }
+
+    return byte;
+}
+
+//-------------------------------------------------------------------------
+
+// Writes straight into the bytes of a raster. The columns changed are
+// kept for each band of eight rows (bands past the eighth share the
+// last), and report() passes them on through rasterChanged(), so that a
+// display sends no more than it would have for the same pixels set one
+// at a time.
+
+template<OledLayout LAYOUT, PixelStyle STYLE>
+class OledRasterPlotter
+{
+public:
+
+    explicit OledRasterPlotter(const OledRaster& raster)
+    :
+        raster_(raster),
+        bands_{}
+    {
+        for (auto& band : bands_)
+        {
+            band = Band{raster_.width, -1};
+        }
+    }
+
+    int width() const { return raster_.width; }
+    int height() const { return raster_.height; }
+
+    void
+    operator()(
+        int x,
+        int y)
+    {
+        if ((x < 0) ||
+            (x >= raster_.width) ||
+            (y < 0) ||
+            (y >= raster_.height))
+        {
+            return;
+        }
+
+        uint8_t* byte;
+        uint8_t mask;
+
+        if (LAYOUT == OledLayout::PageMajor)
+        {
+            byte = raster_.bytes + ((y / 8) * raster_.stride) + x;
+            mask = 1 << (y % 8);
+        }
+        else
+        {
+            byte = raster_.bytes + (y * raster_.stride) + (x / 8);
+            mask = 0x80 >> (x % 8);
+        }
+
+        auto value = applyStyle<STYLE>(*byte, mask);
+
+        if (value != *byte)
+        {
+            *byte = value;
+
+            auto& band = bands_[std::min(y / 8, Bands - 1)];
+            band.first = std::min(band.first, x);
+            band.last = std::max(band.last, x);
+        }
+    }
+
+    template<typename PIXELS>
+    void
+    report(
+        PIXELS& pixels) const
+    {
+        for (auto i = 0 ; i < Bands ; ++i)
+        {
+            auto& band = bands_[i];
+
+            if (band.first <= band.last)
+            {
+                auto bottom = (i == (Bands - 1))
+                            ? raster_.height - 1
+                            : std::min((i * 8) + 7, raster_.height - 1);
+
+                pixels.rasterChanged(OledPoint{band.first, i * 8},
+                                     OledPoint{band.last, bottom});
+            }
+        }
+    }
+
+private:
+
+    static constexpr int Bands{8};
+
+    struct Band
+    {
+        int first;
+        int last;
+    };
+
+    OledRaster raster_;
+    std::array<Band, Bands> bands_;
+};
+
+//-------------------------------------------------------------------------
+
+// For containers without a raster, one virtual call per pixel, with the
+// style still chosen at compile time.
+
+template<PixelStyle STYLE>
+class OledPixelPlotter
+{
+public:
+
+    explicit OledPixelPlotter(OledPixel& pixels)
+    :
+        pixels_(pixels)
+    {
+    }
+
+    int width() const { return pixels_.width(); }
+    int height() const { return pixels_.height(); }
+
+    void
+    operator()(
+        int x,
+        int y)
+    {
+        switch (STYLE)
+        {
+        case PixelStyle::Set:
+
+            pixels_.setPixel(OledPoint{x, y});
+            break;
+
+        case PixelStyle::Unset:
+
+            pixels_.unsetPixel(OledPoint{x, y});
+            break;
+
+        case PixelStyle::Xor:
+
+            pixels_.xorPixel(OledPoint{x, y});
+            break;
+
+        case PixelStyle::None:
+
+            break;
+        }
+    }
+
+private:
+
+    OledPixel& pixels_;
+};
+
+//-------------------------------------------------------------------------
+
+// Call draw(plot) with the plotter that suits pixels. The layout of the
+// raster is looked at once, here, rather than for every pixel.
+
+template<PixelStyle STYLE, typename PIXELS, typename DRAW>
+void
+plotWith(
+    PIXELS& pixels,
+    DRAW draw)
+{
+    static_assert(STYLE != PixelStyle::None, "PixelStyle::None draws nothing");
+
+    auto raster = pixels.raster();
+
+    if (raster.bytes == nullptr)
+    {
+        OledPixelPlotter<STYLE> plot{pixels};
+        draw(plot);
+    }
+    else if (raster.layout == OledLayout::PageMajor)
+    {
+        OledRasterPlotter<OledLayout::PageMajor, STYLE> plot{raster};
+        draw(plot);
+        plot.report(pixels);
+    }
+    else
+    {
+        OledRasterPlotter<OledLayout::RowMajor, STYLE> plot{raster};
+        draw(plot);
+        plot.report(pixels);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// Call draw() with the style as a std::integral_constant, so that a
+// style known only at run time picks a template once, rather than being
+// switched on for every pixel. PixelStyle::None draws nothing, so draw()
+// is not called for it.
+//
+//     dispatchStyle(style, [&](auto s)
+//     {
+//         line<decltype(s)::value>(p1, p2, pixels);
+//     });
+
+template<typename DRAW>
+void
+dispatchStyle(
+    PixelStyle style,
+    DRAW draw)
+{
+    switch (style)
+    {
+    case PixelStyle::Set:
+
+        draw(std::integral_constant<PixelStyle, PixelStyle::Set>{});
+        break;
+
+    case PixelStyle::Unset:
+
+        draw(std::integral_constant<PixelStyle, PixelStyle::Unset>{});
+        break;
+
+    case PixelStyle::Xor:
+
+        draw(std::integral_constant<PixelStyle, PixelStyle::Xor>{});
+        break;
+
+    case PixelStyle::None:
+
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
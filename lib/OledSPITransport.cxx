@@ -0,0 +1,232 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+#include <sys/ioctl.h>
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+#include "OledSPITransport.h"
+
+//------------------------------------------------------------------------
+
+namespace
+{
+    // Bits in the requested GPIO lines.
+
+    constexpr uint64_t DC_LINE{1 << 0};
+    constexpr uint64_t RESET_LINE{1 << 1};
+
+    // spidev's default limit on the size of one transfer.
+
+    constexpr int MAX_TRANSFER{4096};
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledSPITransport::OledSPITransport(
+    const std::string& device,
+    const std::string& gpioChip,
+    unsigned int dcLine,
+    int resetLine,
+    uint32_t speed)
+:
+    spi_{-1},
+    lines_{-1},
+    speed_{speed},
+    hasReset_{resetLine != NoResetLine},
+    dc_{-1},
+    syscalls_{0}
+{
+    spi_ = FileDescriptor{::open(device.c_str(), O_RDWR)};
+
+    if (spi_.fd() == -1)
+    {
+        std::string what( "open "
+                        + device
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    uint8_t mode{SPI_MODE_0};
+    uint8_t bits{8};
+
+    if ((ioctl(spi_.fd(), SPI_IOC_WR_MODE, &mode) == -1) ||
+        (ioctl(spi_.fd(), SPI_IOC_WR_BITS_PER_WORD, &bits) == -1) ||
+        (ioctl(spi_.fd(), SPI_IOC_WR_MAX_SPEED_HZ, &speed_) == -1))
+    {
+        std::string what( "ioctl SPI_IOC_WR " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    FileDescriptor chip{::open(gpioChip.c_str(), O_RDWR)};
+
+    if (chip.fd() == -1)
+    {
+        std::string what( "open "
+                        + gpioChip
+                        + " " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    gpio_v2_line_request request;
+    std::memset(&request, 0, sizeof(request));
+
+    request.offsets[0] = dcLine;
+    request.num_lines = 1;
+
+    if (hasReset_)
+    {
+        request.offsets[1] = resetLine;
+        request.num_lines = 2;
+    }
+
+    request.config.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+    std::strncpy(request.consumer, "libSSD1306", sizeof(request.consumer));
+
+    if (ioctl(chip.fd(), GPIO_V2_GET_LINE_IOCTL, &request) == -1)
+    {
+        std::string what( "ioctl GPIO_V2_GET_LINE " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+
+    lines_ = FileDescriptor{request.fd};
+
+    if (hasReset_)
+    {
+        reset();
+    }
+
+    // Only count what send() costs.
+
+    syscalls_ = 0;
+}
+
+//------------------------------------------------------------------------
+
+SSD1306::OledSPITransport::~OledSPITransport() = default;
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledSPITransport::send(
+    const OledTransaction& transaction)
+{
+    for (const auto& segment : transaction.segments())
+    {
+        int dc = (segment.type == OledTransaction::Type::Data) ? 1 : 0;
+
+        if (dc != dc_)
+        {
+            setLines(dc ? DC_LINE : 0, DC_LINE);
+            dc_ = dc;
+        }
+
+        write(transaction.data(segment), segment.length);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledSPITransport::reset()
+{
+    // RES# must be held low for at least 3us.
+
+    setLines(RESET_LINE, RESET_LINE);
+    usleep(1000);
+    setLines(0, RESET_LINE);
+    usleep(10000);
+    setLines(RESET_LINE, RESET_LINE);
+    usleep(10000);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledSPITransport::setLines(
+    uint64_t bits,
+    uint64_t mask)
+{
+    gpio_v2_line_values values;
+
+    values.bits = bits;
+    values.mask = mask;
+
+    ++syscalls_;
+
+    if (ioctl(lines_.fd(), GPIO_V2_LINE_SET_VALUES_IOCTL, &values) == -1)
+    {
+        std::string what( "ioctl GPIO_V2_LINE_SET_VALUES " __FILE__ "("
+                        + std::to_string(__LINE__)
+                        + ")" );
+        throw std::system_error(errno, std::system_category(), what);
+    }
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledSPITransport::write(
+    const uint8_t* bytes,
+    int length)
+{
+    for (auto offset = 0 ; offset < length ; offset += MAX_TRANSFER)
+    {
+        spi_ioc_transfer transfer;
+        std::memset(&transfer, 0, sizeof(transfer));
+
+        transfer.tx_buf = reinterpret_cast<uintptr_t>(bytes + offset);
+        transfer.len = std::min(length - offset, MAX_TRANSFER);
+        transfer.speed_hz = speed_;
+        transfer.bits_per_word = 8;
+
+        ++syscalls_;
+
+        if (ioctl(spi_.fd(), SPI_IOC_MESSAGE(1), &transfer) == -1)
+        {
+            std::string what( "ioctl SPI_IOC_MESSAGE " __FILE__ "("
+                            + std::to_string(__LINE__)
+                            + ")" );
+            throw std::system_error(errno, std::system_category(), what);
+        }
+    }
+}
+
@@ -0,0 +1,93 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_SPI_TRANSPORT_H
+#define OLED_SPI_TRANSPORT_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+
+#include "FileDescriptor.h"
+#include "OledTransport.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// 4-wire SPI: bytes go out on /dev/spidevB.C while the D/C line, driven
+// through the GPIO character device, selects command or data.
+
+class OledSPITransport
+:
+    public OledTransport
+{
+public:
+
+    static constexpr uint32_t DefaultSpeed{8000000};
+    static constexpr int NoResetLine{-1};
+
+    OledSPITransport(
+        const std::string& device,
+        const std::string& gpioChip,
+        unsigned int dcLine,
+        int resetLine = NoResetLine,
+        uint32_t speed = DefaultSpeed);
+
+    ~OledSPITransport() override;
+
+    OledSPITransport(const OledSPITransport&) = delete;
+    OledSPITransport& operator= (const OledSPITransport&) = delete;
+
+    void send(const OledTransaction& transaction) override;
+    uint64_t syscalls() const override { return syscalls_; }
+
+private:
+
+    void reset();
+    void setLines(uint64_t bits, uint64_t mask);
+    void write(const uint8_t* bytes, int length);
+
+    FileDescriptor spi_;
+    FileDescriptor lines_;
+    uint32_t speed_;
+    bool hasReset_;
+    int dc_;
+    uint64_t syscalls_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,649 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_STATIC_GRAPHICS_H
+#define OLED_STATIC_GRAPHICS_H
+
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "OledPixel.h"
+#include "OledPlotter.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// The drawing functions of OledGraphics.h that work a pixel at a time,
+// with the style as a template parameter and the pixel container as its
+// own type. Everything here is inlined into the caller, so drawing on an
+// OledBitmap or an OledDisplay writes the bytes in place with no virtual
+// call or style switch per pixel. PixelStyle::None is rejected when the
+// template is instantiated, as there is nothing to draw.
+//
+//     SSD1306::line<SSD1306::PixelStyle::Set>(p1, p2, bitmap);
+//
+// The functions in OledGraphics.h that take the style as an argument
+// choose one of these once per call.
+
+//-------------------------------------------------------------------------
+
+namespace detail
+{
+
+//-------------------------------------------------------------------------
+
+int sine(int angle);
+int cosine(int angle);
+
+//-------------------------------------------------------------------------
+
+inline
+int64_t
+floorDiv(
+    int64_t numerator,
+    int64_t denominator)
+{
+    auto quotient = numerator / denominator;
+
+    if (((numerator % denominator) != 0) &&
+        ((numerator < 0) != (denominator < 0)))
+    {
+        --quotient;
+    }
+
+    return quotient;
+}
+
+//-------------------------------------------------------------------------
+
+inline
+int64_t
+ceilDiv(
+    int64_t numerator,
+    int64_t denominator)
+{
+    return -floorDiv(-numerator, denominator);
+}
+
+//-------------------------------------------------------------------------
+
+// One axis of a line: where it starts, which way it goes, how far, and
+// the size of the target along that axis.
+
+struct Axis
+{
+    int start;
+    int sign;
+    int64_t delta;
+    int size;
+};
+
+//-------------------------------------------------------------------------
+
+// The steps [first, last] along the line for which the axis stays inside
+// the target. Empty when first > last.
+
+inline
+void
+visibleSteps(
+    const Axis& axis,
+    int64_t& first,
+    int64_t& last)
+{
+    if (axis.sign > 0)
+    {
+        first = -int64_t{axis.start};
+        last = int64_t{axis.size} - 1 - axis.start;
+    }
+    else
+    {
+        first = int64_t{axis.start} - (axis.size - 1);
+        last = axis.start;
+    }
+
+    first = std::max(first, int64_t{0});
+    last = std::min(last, axis.delta);
+}
+
+//-------------------------------------------------------------------------
+
+// Bresenham's algorithm, as line() has always drawn it, but starting and
+// stopping at the edges of the target rather than stepping through
+// every point off it.
+//
+// After i steps along the major axis, the midpoint decision variable has
+// moved the minor axis
+//
+//     k(i) = floor((2 * i * minor + major - 1) / (2 * major))
+//
+// steps. k(i) never decreases, so the range of k that lies inside the
+// target maps back to a range of i, and the decision variable at the
+// first visible step is
+//
+//     d(i) = 2 * minor - major + 2 * i * minor - 2 * k(i) * major
+//
+// The arithmetic is exact in 64 bits for any line shorter than 2^31
+// pixels along its major axis.
+
+template<typename PLOT>
+void
+clippedLine(
+    const Axis& major,
+    const Axis& minor,
+    int64_t lastStep,
+    PLOT plot)
+{
+    int64_t first;
+    int64_t last;
+    visibleSteps(major, first, last);
+    last = std::min(last, lastStep);
+
+    int64_t minorFirst;
+    int64_t minorLast;
+    visibleSteps(minor, minorFirst, minorLast);
+
+    if ((first > last) || (minorFirst > minorLast))
+    {
+        return;
+    }
+
+    auto twoMajor = 2 * major.delta;
+    auto twoMinor = 2 * minor.delta;
+
+    first = std::max(first,
+                     ceilDiv((twoMajor * minorFirst) - major.delta + 1,
+                             twoMinor));
+    last = std::min(last,
+                    floorDiv((twoMajor * (minorLast + 1)) - major.delta,
+                             twoMinor));
+
+    if (first > last)
+    {
+        return;
+    }
+
+    auto k = floorDiv((twoMinor * first) + major.delta - 1, twoMajor);
+    auto d = twoMinor - major.delta + (twoMinor * first) - (twoMajor * k);
+
+    for (auto i = first ; i <= last ; ++i)
+    {
+        plot(static_cast<int>(major.start + (major.sign * i)),
+             static_cast<int>(minor.start + (minor.sign * k)));
+
+        if (d <= 0)
+        {
+            d += twoMinor;
+        }
+        else
+        {
+            d += twoMinor - twoMajor;
+            ++k;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// The part of a circle between two angles, as the directions of its two
+// edges. A point is inside when it lies clockwise of the start edge and
+// anticlockwise of the end edge; for sweeps of more than 180 degrees,
+// either will do.
+
+class Sweep
+{
+public:
+
+    Sweep(
+        int startAngle,
+        int endAngle)
+    :
+        startX_{cosine(startAngle)},
+        startY_{sine(startAngle)},
+        endX_{cosine(endAngle)},
+        endY_{sine(endAngle)},
+        full_{false},
+        wide_{false}
+    {
+        auto span = int64_t{endAngle} - startAngle;
+
+        if (span >= 360)
+        {
+            full_ = true;
+        }
+        else if (span < 0)
+        {
+            span = ((span % 360) + 360) % 360;
+        }
+
+        wide_ = (span > 180);
+    }
+
+    bool full() const { return full_; }
+
+    bool
+    inside(
+        int64_t x,
+        int64_t y) const
+    {
+        if (full_)
+        {
+            return true;
+        }
+
+        auto afterStart = ((startX_ * y) - (startY_ * x)) >= 0;
+        auto beforeEnd = ((x * endY_) - (y * endX_)) >= 0;
+
+        if (wide_)
+        {
+            return afterStart || beforeEnd;
+        }
+
+        // Without this, a narrow sweep would also take in the points
+        // directly opposite it.
+
+        auto ahead = ((x * (startX_ + endX_)) + (y * (startY_ + endY_))) >= 0;
+
+        return afterStart && beforeEnd && ahead;
+    }
+
+private:
+
+    int64_t startX_;
+    int64_t startY_;
+    int64_t endX_;
+    int64_t endY_;
+    bool full_;
+    bool wide_;
+};
+
+//-------------------------------------------------------------------------
+
+// Visit (x, y) reflected into all four quadrants, visiting points on the
+// axes only once, so that Xor drawing does not undo itself.
+
+template<typename POINT>
+void
+quadrants(
+    int x,
+    int y,
+    POINT point)
+{
+    point(x, y);
+
+    if (x != 0)
+    {
+        point(-x, y);
+    }
+
+    if (y != 0)
+    {
+        point(x, -y);
+
+        if (x != 0)
+        {
+            point(-x, -y);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// The midpoint circle algorithm. circlePoints() visits each pixel of the
+// outline once; circleRows() visits each row once, with the half width
+// of the circle on that row.
+
+template<typename POINT>
+void
+circlePoints(
+    int radius,
+    POINT point)
+{
+    int x = 0;
+    int y = radius;
+    int64_t d = 1 - int64_t{radius};
+
+    while (x <= y)
+    {
+        quadrants(x, y, point);
+
+        if (x != y)
+        {
+            quadrants(y, x, point);
+        }
+
+        if (d < 0)
+        {
+            d += (2 * int64_t{x}) + 3;
+        }
+        else
+        {
+            d += (2 * (int64_t{x} - y)) + 5;
+            --y;
+        }
+
+        ++x;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// The midpoint ellipse algorithm, scaled by four to keep to integers.
+// Visits one quadrant from the top (0, radiusY) to the right hand end
+// (radiusX, 0), x never decreasing and y never increasing.
+
+template<typename POINT>
+void
+ellipseQuadrant(
+    int radiusX,
+    int radiusY,
+    POINT point)
+{
+    int64_t a2 = int64_t{radiusX} * radiusX;
+    int64_t b2 = int64_t{radiusY} * radiusY;
+
+    int x = 0;
+    int y = radiusY;
+
+    int64_t dx = 0;
+    int64_t dy = 2 * a2 * y;
+    int64_t d = (4 * b2) - (4 * a2 * radiusY) + a2;
+
+    while (dx < dy)
+    {
+        point(x, y);
+
+        ++x;
+        dx += 2 * b2;
+
+        if (d < 0)
+        {
+            d += 4 * (dx + b2);
+        }
+        else
+        {
+            --y;
+            dy -= 2 * a2;
+            d += 4 * (dx - dy + b2);
+        }
+    }
+
+    d = (b2 * ((2 * int64_t{x}) + 1) * ((2 * int64_t{x}) + 1))
+      + (4 * a2 * (int64_t{y} - 1) * (int64_t{y} - 1))
+      - (4 * a2 * b2);
+
+    while (y >= 0)
+    {
+        point(x, y);
+
+        --y;
+        dy -= 2 * a2;
+
+        if (d > 0)
+        {
+            d += 4 * (a2 - dy);
+        }
+        else
+        {
+            ++x;
+            dx += 2 * b2;
+            d += 4 * (dx - dy + a2);
+        }
+    }
+
+    // Very flat ellipses run out of rows before reaching the end.
+
+    while (x < radiusX)
+    {
+        ++x;
+        point(x, 0);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// Draw a line, optionally leaving off its last pixel so that lines
+// joined end to end draw each shared point once.
+
+template<PixelStyle STYLE, typename PIXELS>
+void
+drawLine(
+    const OledPoint& p1,
+    const OledPoint& p2,
+    bool includeEnd,
+    PIXELS& pixels)
+{
+    static_assert(STYLE != PixelStyle::None, "PixelStyle::None draws nothing");
+
+    if ((p1.x() == p2.x()) && (p1.y() == p2.y()))
+    {
+        if (includeEnd)
+        {
+            plotWith<STYLE>(pixels, [&](auto& plot)
+            {
+                plot(p1.x(), p1.y());
+            });
+        }
+    }
+    else if (p1.y() == p2.y())
+    {
+        auto end = p2.x();
+
+        if (not includeEnd)
+        {
+            end += (p1.x() < p2.x()) ? -1 : 1;
+        }
+
+        pixels.horizontalSpan(p1.x(), end, p1.y(), STYLE);
+    }
+    else if (p1.x() == p2.x())
+    {
+        auto end = p2.y();
+
+        if (not includeEnd)
+        {
+            end += (p1.y() < p2.y()) ? -1 : 1;
+        }
+
+        pixels.verticalSpan(p1.x(), p1.y(), end, STYLE);
+    }
+    else
+    {
+        int64_t dx = std::abs(int64_t{p2.x()} - p1.x());
+        int64_t dy = std::abs(int64_t{p2.y()} - p1.y());
+
+        int sign_x = (p1.x() <= p2.x()) ? 1 : -1;
+        int sign_y = (p1.y() <= p2.y()) ? 1 : -1;
+
+        auto lastStep = includeEnd ? std::max(dx, dy) : std::max(dx, dy) - 1;
+
+        plotWith<STYLE>(pixels, [&](auto& plot)
+        {
+            if (dx > dy)
+            {
+                Axis major{p1.x(), sign_x, dx, plot.width()};
+                Axis minor{p1.y(), sign_y, dy, plot.height()};
+
+                clippedLine(major, minor, lastStep, [&](int x, int y)
+                {
+                    plot(x, y);
+                });
+            }
+            else
+            {
+                Axis major{p1.y(), sign_y, dy, plot.height()};
+                Axis minor{p1.x(), sign_x, dx, plot.width()};
+
+                clippedLine(major, minor, lastStep, [&](int y, int x)
+                {
+                    plot(x, y);
+                });
+            }
+        });
+    }
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace detail
+
+//-------------------------------------------------------------------------
+
+template<PixelStyle STYLE, typename PIXELS>
+void
+arc(
+    const OledPoint& center,
+    int radius,
+    int startAngle,
+    int endAngle,
+    PIXELS& pixels)
+{
+    if (radius < 0)
+    {
+        return;
+    }
+
+    detail::Sweep sweep{startAngle, endAngle};
+
+    plotWith<STYLE>(pixels, [&](auto& plot)
+    {
+        detail::circlePoints(radius, [&](int x, int y)
+        {
+            if (sweep.inside(x, y))
+            {
+                plot(center.x() + x, center.y() + y);
+            }
+        });
+    });
+}
+
+//-------------------------------------------------------------------------
+
+template<PixelStyle STYLE, typename PIXELS>
+void
+circle(
+    const OledPoint& center,
+    int radius,
+    PIXELS& pixels)
+{
+    if (radius < 0)
+    {
+        return;
+    }
+
+    plotWith<STYLE>(pixels, [&](auto& plot)
+    {
+        detail::circlePoints(radius, [&](int x, int y)
+        {
+            plot(center.x() + x, center.y() + y);
+        });
+    });
+}
+
+//-------------------------------------------------------------------------
+
+template<PixelStyle STYLE, typename PIXELS>
+void
+ellipse(
+    const OledPoint& center,
+    int radiusX,
+    int radiusY,
+    PIXELS& pixels)
+{
+    if ((radiusX < 0) || (radiusY < 0))
+    {
+        return;
+    }
+
+    plotWith<STYLE>(pixels, [&](auto& plot)
+    {
+        detail::ellipseQuadrant(radiusX, radiusY, [&](int x, int y)
+        {
+            detail::quadrants(x, y, [&](int px, int py)
+            {
+                plot(center.x() + px, center.y() + py);
+            });
+        });
+    });
+}
+
+//-------------------------------------------------------------------------
+
+template<PixelStyle STYLE, typename PIXELS>
+void
+line(
+    const OledPoint& p1,
+    const OledPoint& p2,
+    PIXELS& pixels)
+{
+    detail::drawLine<STYLE>(p1, p2, true, pixels);
+}
+
+//-------------------------------------------------------------------------
+
+template<PixelStyle STYLE, typename PIXELS>
+void
+polygon(
+    const OledPoint* points,
+    int count,
+    PIXELS& pixels)
+{
+    if ((points == nullptr) || (count < 1))
+    {
+        return;
+    }
+
+    if (count == 1)
+    {
+        detail::drawLine<STYLE>(points[0], points[0], true, pixels);
+        return;
+    }
+
+    for (auto i = 0 ; i < count ; ++i)
+    {
+        detail::drawLine<STYLE>(points[i],
+                                points[(i + 1) % count],
+                                false,
+                                pixels);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,140 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "OledSurface.h"
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledSurface::OledSurface(
+    int width,
+    int height)
+:
+    width_{width},
+    height_{height},
+    pages_{}
+{
+    if ((width < 0) || (height < 0))
+    {
+        throw std::invalid_argument("surface size must not be negative");
+    }
+
+    pages_.resize(width * ((height + 7) / 8));
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledSurface::clear()
+{
+    std::fill(pages_.begin(), pages_.end(), 0x00);
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledSurface::fill()
+{
+    std::fill(pages_.begin(), pages_.end(), 0xFF);
+}
+
+//-------------------------------------------------------------------------
+
+bool
+SSD1306::OledSurface::isSetPixel(
+    SSD1306::OledPoint p) const
+{
+    if (not pixelInside(p))
+    {
+        return false;
+    }
+
+    return pages_[((p.y() / 8) * width_) + p.x()] & (1 << (p.y() % 8));
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledSurface::setPixel(
+    SSD1306::OledPoint p)
+{
+    if (pixelInside(p))
+    {
+        pages_[((p.y() / 8) * width_) + p.x()] |= (1 << (p.y() % 8));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledSurface::unsetPixel(
+    SSD1306::OledPoint p)
+{
+    if (pixelInside(p))
+    {
+        pages_[((p.y() / 8) * width_) + p.x()] &= ~(1 << (p.y() % 8));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledSurface::xorPixel(
+    SSD1306::OledPoint p)
+{
+    if (pixelInside(p))
+    {
+        pages_[((p.y() / 8) * width_) + p.x()] ^= (1 << (p.y() % 8));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledRaster
+SSD1306::OledSurface::raster()
+{
+    return OledRaster{OledLayout::PageMajor,
+                      width_,
+                      height_,
+                      width_,
+                      pages_.empty() ? nullptr : pages_.data()};
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledConstRaster
+SSD1306::OledSurface::raster() const
+{
+    return OledConstRaster{OledLayout::PageMajor,
+                           width_,
+                           height_,
+                           width_,
+                           pages_.empty() ? nullptr : pages_.data()};
+}
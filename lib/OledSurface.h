@@ -0,0 +1,90 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_SURFACE_H
+#define OLED_SURFACE_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OledPixel.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// Like a page-major OledBitmap, but sized when it is constructed rather
+// than when it is compiled, for pixels whose size is only known at run
+// time (rendered text, for example).
+
+class OledSurface
+:
+    public OledPixel
+{
+public:
+
+    OledSurface(int width, int height);
+
+    void clear() override;
+    void fill() override;
+    bool isSetPixel(SSD1306::OledPoint p) const override;
+    void setPixel(SSD1306::OledPoint p) override;
+    void unsetPixel(SSD1306::OledPoint p) override;
+    void xorPixel(SSD1306::OledPoint p) override;
+
+    int width() const override { return width_; }
+    int height() const override { return height_; }
+
+    OledRaster raster() override;
+    OledConstRaster raster() const override;
+
+    // Bytes of pixel storage.
+
+    size_t size() const { return pages_.size(); }
+
+private:
+
+    int width_;
+    int height_;
+    std::vector<uint8_t> pages_;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,74 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_TEXT_H
+#define OLED_TEXT_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// The code point for characters that can't be decoded.
+
+constexpr uint32_t ReplacementCharacter{0xFFFD};
+
+//-------------------------------------------------------------------------
+
+// Decode the UTF-8 character at string, which must be before end, and
+// move string past it. If the bytes there are not a well-formed
+// character (truncated, overlong, a surrogate or beyond U+10FFFF) return
+// false, set code to the first byte and move string past that byte only.
+
+bool decodeUtf8(const char*& string, const char* end, uint32_t& code);
+
+//-------------------------------------------------------------------------
+
+// The glyph for code in the code page 437 order of the fixed fonts, or
+// fallback if they have none. ASCII, control characters included, maps
+// to itself.
+
+uint8_t codePage437(uint32_t code, uint8_t fallback = '?');
+
+// The code point that codePage437() maps to glyph.
+
+uint32_t fromCodePage437(uint8_t glyph);
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
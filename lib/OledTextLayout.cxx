@@ -0,0 +1,342 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+
+#include "OledText.h"
+#include "OledTextLayout.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+std::vector<uint32_t>
+codePoints(
+    const SSD1306::OledTypeface& typeface,
+    const std::string& string)
+{
+    std::vector<uint32_t> codes;
+    codes.reserve(string.size());
+
+    auto next = string.data();
+    auto end = next + string.size();
+
+    while (next != end)
+    {
+        uint32_t code;
+
+        if (not SSD1306::decodeUtf8(next, end, code))
+        {
+            code = typeface.invalidByte(code);
+        }
+
+        codes.push_back(code);
+    }
+
+    return codes;
+}
+
+//-------------------------------------------------------------------------
+
+// The code points [first, last) of one line of the layout, and their
+// total advance.
+
+struct Line
+{
+    size_t first;
+    size_t last;
+    int width;
+};
+
+//-------------------------------------------------------------------------
+
+int
+widthOf(
+    const std::vector<int>& advances,
+    size_t first,
+    size_t last)
+{
+    int width = 0;
+
+    for (auto i = first ; i < last ; ++i)
+    {
+        width += advances[i];
+    }
+
+    return width;
+}
+
+//-------------------------------------------------------------------------
+
+// Break the paragraph [first, last), which holds no '\n', into lines no
+// wider than wrapWidth. Lines break at the last space that lets them fit
+// or, failing that, within a word; spaces at either side of the break,
+// and at the end of the paragraph, are dropped.
+
+void
+breakLines(
+    const std::vector<uint32_t>& codes,
+    const std::vector<int>& advances,
+    size_t first,
+    size_t last,
+    int wrapWidth,
+    std::vector<Line>& lines)
+{
+    auto wrap = (wrapWidth != SSD1306::OledTextLayout::NoWrap);
+    auto start = first;
+
+    do
+    {
+        auto end = start;
+        auto space = start;
+        auto width = 0;
+
+        // Spaces may hang past the edge; a line only overflows at a
+        // character that is not a space.
+
+        while (end < last)
+        {
+            if (codes[end] == ' ')
+            {
+                space = end;
+            }
+            else if (wrap &&
+                     (end > start) &&
+                     (width + advances[end] > wrapWidth))
+            {
+                break;
+            }
+
+            width += advances[end];
+            ++end;
+        }
+
+        auto trimmed = end;
+
+        if (wrap)
+        {
+            auto trim = [&](size_t position)
+            {
+                while ((position > start) && (codes[position - 1] == ' '))
+                {
+                    --position;
+                }
+
+                return position;
+            };
+
+            if ((end < last) && (trim(space) > start))
+            {
+                end = space;
+            }
+
+            trimmed = trim(end);
+        }
+
+        lines.push_back(Line{start,
+                             trimmed,
+                             widthOf(advances, start, trimmed)});
+
+        start = end;
+
+        while (wrap && (start < last) && (codes[start] == ' '))
+        {
+            ++start;
+        }
+    }
+    while (start < last);
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledSize
+SSD1306::measureString(
+    const OledTypeface& typeface,
+    const std::string& string)
+{
+    auto width = 0;
+    auto lineWidth = 0;
+    auto lines = 1;
+
+    auto next = string.data();
+    auto end = next + string.size();
+
+    while (next != end)
+    {
+        uint32_t code;
+
+        if (not decodeUtf8(next, end, code))
+        {
+            code = typeface.invalidByte(code);
+        }
+
+        if (code == '\n')
+        {
+            width = std::max(width, lineWidth);
+            lineWidth = 0;
+            ++lines;
+        }
+        else
+        {
+            lineWidth += typeface.advance(code);
+        }
+    }
+
+    return OledSize{std::max(width, lineWidth),
+                    lines * typeface.lineHeight()};
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledTextLayout::OledTextLayout(
+    const OledTypeface& typeface,
+    const std::string& string,
+    int wrapWidth,
+    TextAlign align)
+:
+    typeface_(typeface),
+    glyphs_{},
+    size_{0, 0},
+    overhang_{0, 0, 0, 0}
+{
+    auto codes = codePoints(typeface, string);
+
+    std::vector<int> advances(codes.size());
+
+    std::transform(codes.begin(),
+                   codes.end(),
+                   advances.begin(),
+                   [&typeface](uint32_t code)
+                   {
+                       return (code == '\n') ? 0 : typeface.advance(code);
+                   });
+
+    std::vector<Line> lines;
+    size_t paragraph = 0;
+
+    do
+    {
+        auto first = codes.begin() + paragraph;
+        auto last = std::find(first, codes.end(), uint32_t('\n'));
+        auto end = paragraph + (last - first);
+
+        breakLines(codes, advances, paragraph, end, wrapWidth, lines);
+
+        paragraph = end + 1;
+    }
+    while (paragraph <= codes.size());
+
+    auto boxWidth = wrapWidth;
+
+    if (wrapWidth == NoWrap)
+    {
+        for (const auto& line : lines)
+        {
+            boxWidth = std::max(boxWidth, line.width);
+        }
+    }
+
+    auto lineHeight = typeface.lineHeight();
+    auto y = 0;
+
+    for (const auto& line : lines)
+    {
+        auto x = 0;
+
+        switch (align)
+        {
+        case TextAlign::Left:
+
+            break;
+
+        case TextAlign::Center:
+
+            x = (boxWidth - line.width) / 2;
+            break;
+
+        case TextAlign::Right:
+
+            x = boxWidth - line.width;
+            break;
+        }
+
+        for (auto i = line.first ; i < line.last ; ++i)
+        {
+            glyphs_.push_back(Glyph{OledPoint{x, y}, codes[i]});
+
+            auto reach = typeface.overhang(codes[i]);
+
+            overhang_.left = std::max(overhang_.left, reach.left - x);
+            overhang_.top = std::max(overhang_.top, reach.top - y);
+            overhang_.right = std::max(overhang_.right,
+                                       x + advances[i] + reach.right
+                                       - boxWidth);
+            overhang_.bottom = std::max(overhang_.bottom,
+                                        y + lineHeight + reach.bottom);
+
+            x += advances[i];
+        }
+
+        y += lineHeight;
+    }
+
+    size_ = OledSize{boxWidth, y};
+    overhang_.bottom = std::max(0, overhang_.bottom - y);
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledTextLayout::draw(
+    const OledPoint& p,
+    PixelStyle style,
+    OledPixel& pixels,
+    GlyphMode mode) const
+{
+    if ((style == PixelStyle::None) && (mode == GlyphMode::Transparent))
+    {
+        return;
+    }
+
+    for (const auto& glyph : glyphs_)
+    {
+        typeface_.drawChar(OledPoint{p.x() + glyph.offset.x(),
+                                     p.y() + glyph.offset.y()},
+                           glyph.code,
+                           style,
+                           pixels,
+                           mode);
+    }
+}
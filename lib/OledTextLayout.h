@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_TEXT_LAYOUT_H
+#define OLED_TEXT_LAYOUT_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OledGlyph.h"
+#include "OledPixel.h"
+#include "OledTypeface.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+struct OledSize
+{
+    int width;
+    int height;
+};
+
+enum class TextAlign
+{
+    Left,
+    Center,
+    Right
+};
+
+//-------------------------------------------------------------------------
+
+// The size of string (UTF-8, '\n' between lines) as drawn one character
+// after another: the widest line by the number of lines. Bytes that are
+// not UTF-8 are measured as the typeface's invalidByte().
+
+OledSize measureString(const OledTypeface& typeface,
+                       const std::string& string);
+
+//-------------------------------------------------------------------------
+
+// string broken into lines and positioned, once, so that it can be drawn
+// any number of times without being decoded or measured again.
+//
+// With a wrapWidth, lines are broken at the last space that lets them
+// fit, or within a word too long for a line of its own, spaces at the
+// ends of lines are dropped, and lines are aligned in a box wrapWidth
+// wide. With NoWrap, lines break only at '\n' and are aligned in a box
+// as wide as the widest line. Bytes that are not UTF-8 are laid out as
+// the typeface's invalidByte().
+//
+// The typeface must outlive the layout.
+
+class OledTextLayout
+{
+public:
+
+    static constexpr int NoWrap{0};
+
+    struct Glyph
+    {
+        OledPoint offset;
+        uint32_t code;
+    };
+
+    OledTextLayout(const OledTypeface& typeface,
+                   const std::string& string,
+                   int wrapWidth = NoWrap,
+                   TextAlign align = TextAlign::Left);
+
+    const OledTypeface& typeface() const { return typeface_; }
+    const std::vector<Glyph>& glyphs() const { return glyphs_; }
+    OledSize size() const { return size_; }
+
+    // How far the glyphs reach beyond the box, when they overhang their
+    // cells.
+
+    OledOverhang overhang() const { return overhang_; }
+
+    // Draw with p at the top left of the box.
+
+    void
+    draw(
+        const OledPoint& p,
+        PixelStyle style,
+        OledPixel& pixels,
+        GlyphMode mode = GlyphMode::Opaque) const;
+
+private:
+
+    const OledTypeface& typeface_;
+    std::vector<Glyph> glyphs_;
+    OledSize size_;
+    OledOverhang overhang_;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
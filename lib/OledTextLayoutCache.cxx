@@ -0,0 +1,133 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <algorithm>
+#include <functional>
+
+#include "OledTextLayoutCache.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+size_t
+combine(
+    size_t seed,
+    size_t value)
+{
+    return seed ^ (value + 0x9E3779B9 + (seed << 6) + (seed >> 2));
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledTextLayoutCache::OledTextLayoutCache(
+    size_t capacity)
+:
+    capacity_{std::max(capacity, size_t(1))},
+    entries_{},
+    index_{}
+{
+}
+
+//-------------------------------------------------------------------------
+
+const SSD1306::OledTextLayout&
+SSD1306::OledTextLayoutCache::layout(
+    const OledTypeface& typeface,
+    const std::string& string,
+    int wrapWidth,
+    TextAlign align)
+{
+    auto hash = std::hash<std::string>{}(string);
+    hash = combine(hash, std::hash<const void*>{}(&typeface));
+    hash = combine(hash, std::hash<int>{}(wrapWidth));
+    hash = combine(hash, static_cast<size_t>(align));
+
+    auto candidates = index_.equal_range(hash);
+
+    for (auto i = candidates.first ; i != candidates.second ; ++i)
+    {
+        auto entry = i->second;
+
+        if ((&(entry->layout.typeface()) == &typeface) &&
+            (entry->wrapWidth == wrapWidth) &&
+            (entry->align == align) &&
+            (entry->string == string))
+        {
+            entries_.splice(entries_.begin(), entries_, entry);
+
+            return entry->layout;
+        }
+    }
+
+    if (entries_.size() == capacity_)
+    {
+        auto oldest = std::prev(entries_.end());
+        auto range = index_.equal_range(oldest->hash);
+
+        for (auto i = range.first ; i != range.second ; ++i)
+        {
+            if (i->second == oldest)
+            {
+                index_.erase(i);
+                break;
+            }
+        }
+
+        entries_.erase(oldest);
+    }
+
+    entries_.push_front(Entry{hash,
+                              string,
+                              wrapWidth,
+                              align,
+                              OledTextLayout{typeface,
+                                             string,
+                                             wrapWidth,
+                                             align}});
+
+    index_.emplace(hash, entries_.begin());
+
+    return entries_.front().layout;
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledTextLayoutCache::clear()
+{
+    index_.clear();
+    entries_.clear();
+}
@@ -0,0 +1,102 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_TEXT_LAYOUT_CACHE_H
+#define OLED_TEXT_LAYOUT_CACHE_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "OledTextLayout.h"
+#include "OledTypeface.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// Layouts of recently drawn strings, so that a label redrawn every frame
+// is decoded, measured and broken into lines only once. Layouts are found
+// by a hash of the string, typeface, wrap width and alignment; when the
+// cache is full the least recently used is dropped.
+
+class OledTextLayoutCache
+{
+public:
+
+    static constexpr size_t DefaultCapacity{32};
+
+    explicit OledTextLayoutCache(size_t capacity = DefaultCapacity);
+
+    // The layout stays valid until the next call to layout() or clear().
+
+    const OledTextLayout&
+    layout(
+        const OledTypeface& typeface,
+        const std::string& string,
+        int wrapWidth = OledTextLayout::NoWrap,
+        TextAlign align = TextAlign::Left);
+
+    void clear();
+
+    size_t capacity() const { return capacity_; }
+    size_t size() const { return entries_.size(); }
+
+private:
+
+    struct Entry
+    {
+        size_t hash;
+        std::string string;
+        int wrapWidth;
+        TextAlign align;
+        OledTextLayout layout;
+    };
+
+    // Most recently used first.
+
+    using Entries = std::list<Entry>;
+
+    size_t capacity_;
+    Entries entries_;
+    std::unordered_multimap<size_t, Entries::iterator> index_;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
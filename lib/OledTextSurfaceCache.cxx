@@ -0,0 +1,254 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include <functional>
+#include <iterator>
+
+#include "OledBlit.h"
+#include "OledTextLayout.h"
+#include "OledTextSurfaceCache.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+size_t
+combine(
+    size_t seed,
+    size_t value)
+{
+    return seed ^ (value + 0x9E3779B9 + (seed << 6) + (seed >> 2));
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledTextSurfaceCache::OledTextSurfaceCache(
+    size_t budget)
+:
+    budget_{budget},
+    bytes_{0},
+    hits_{0},
+    misses_{0},
+    entries_{},
+    index_{}
+{
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledTextSurfaceCache::draw(
+    const OledPoint& p,
+    const OledTypeface& typeface,
+    const std::string& string,
+    PixelStyle style,
+    OledPixel& pixels,
+    GlyphMode mode)
+{
+    // The text is rendered onto a clear surface so that one raster
+    // operation puts it on pixels. Transparent text in Set and Unset
+    // shares one rendering in Set. Xor is rendered in Xor, so that glyphs
+    // that overlap cancel out as they do when drawn directly.
+
+    auto render = style;
+    auto op = RasterOp::Copy;
+
+    if (mode == GlyphMode::Transparent)
+    {
+        render = PixelStyle::Set;
+
+        switch (style)
+        {
+        case PixelStyle::Set:
+
+            op = RasterOp::Set;
+            break;
+
+        case PixelStyle::Unset:
+
+            op = RasterOp::Unset;
+            break;
+
+        case PixelStyle::Xor:
+
+            render = PixelStyle::Xor;
+            op = RasterOp::Xor;
+            break;
+
+        case PixelStyle::None:
+
+            return;
+        }
+    }
+    else
+    {
+        switch (style)
+        {
+        case PixelStyle::Set:
+        case PixelStyle::Unset:
+
+            op = RasterOp::Copy;
+            break;
+
+        case PixelStyle::Xor:
+        case PixelStyle::None:
+
+            op = RasterOp::Xor;
+            break;
+        }
+    }
+
+    auto hash = std::hash<std::string>{}(string);
+    hash = combine(hash, std::hash<const void*>{}(&typeface));
+    hash = combine(hash, static_cast<size_t>(render));
+    hash = combine(hash, static_cast<size_t>(mode));
+
+    auto candidates = index_.equal_range(hash);
+
+    for (auto i = candidates.first ; i != candidates.second ; ++i)
+    {
+        auto entry = i->second;
+
+        if ((entry->typeface == &typeface) &&
+            (entry->style == render) &&
+            (entry->mode == mode) &&
+            (entry->string == string))
+        {
+            ++hits_;
+            entries_.splice(entries_.begin(), entries_, entry);
+            blit(entry->surface,
+                 OledPoint{p.x() - entry->origin.x(),
+                           p.y() - entry->origin.y()},
+                 op,
+                 pixels);
+
+            return;
+        }
+    }
+
+    ++misses_;
+
+    OledTextLayout layout{typeface, string};
+
+    // Glyphs that overhang the box are rendered too, with the box at
+    // origin on the surface. Outside the box an opaque string only draws
+    // its glyphs, which a copy of the surface would not do, so such
+    // strings are drawn directly.
+
+    auto size = layout.size();
+    auto overhang = layout.overhang();
+
+    auto overhangs = (overhang.left > 0) ||
+                     (overhang.top > 0) ||
+                     (overhang.right > 0) ||
+                     (overhang.bottom > 0);
+
+    auto width = overhang.left + size.width + overhang.right;
+    auto height = overhang.top + size.height + overhang.bottom;
+    auto bytes = size_t(width) * ((height + 7) / 8);
+
+    if ((bytes > budget_) || (overhangs && (op == RasterOp::Copy)))
+    {
+        layout.draw(p, style, pixels, mode);
+
+        return;
+    }
+
+    OledPoint origin{overhang.left, overhang.top};
+
+    OledSurface surface{width, height};
+    layout.draw(origin, render, surface, mode);
+
+    entries_.push_front(Entry{hash,
+                              &typeface,
+                              string,
+                              render,
+                              mode,
+                              origin,
+                              std::move(surface)});
+
+    index_.emplace(hash, entries_.begin());
+    bytes_ += bytes;
+
+    evict();
+
+    blit(entries_.front().surface,
+         OledPoint{p.x() - origin.x(), p.y() - origin.y()},
+         op,
+         pixels);
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledTextSurfaceCache::clear()
+{
+    index_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledTextSurfaceCache::resetCounters()
+{
+    hits_ = 0;
+    misses_ = 0;
+}
+
+//-------------------------------------------------------------------------
+
+void
+SSD1306::OledTextSurfaceCache::evict()
+{
+    while (bytes_ > budget_)
+    {
+        auto oldest = std::prev(entries_.end());
+        auto range = index_.equal_range(oldest->hash);
+
+        for (auto i = range.first ; i != range.second ; ++i)
+        {
+            if (i->second == oldest)
+            {
+                index_.erase(i);
+                break;
+            }
+        }
+
+        bytes_ -= oldest->surface.size();
+        entries_.erase(oldest);
+    }
+}
@@ -0,0 +1,134 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_TEXT_SURFACE_CACHE_H
+#define OLED_TEXT_SURFACE_CACHE_H
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+#include "OledGlyph.h"
+#include "OledPixel.h"
+#include "OledSurface.h"
+#include "OledTypeface.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// Pre-rendered text for labels that are drawn again and again. Each
+// string is rendered once, by OledTextLayout without wrapping, into a
+// page-major OledSurface; drawing it again is a single blit of that
+// surface. Surfaces are found by string, typeface, style and mode, and
+// the least recently used are dropped to keep their pixels within
+// budget bytes. Strings too big for the budget are drawn directly.
+//
+// In GlyphMode::Opaque the surface covers the whole box of the text, the
+// widest line by the number of lines. For one line that is exactly the
+// cells drawString8xN() would draw. Bytes that are not UTF-8 are drawn as
+// the typeface's invalidByte(), so with typeface8xN() a label in code
+// page 437, such as "\xFD", still matches drawString8xN().
+//
+// Glyphs that overhang the box, as an OledFont's may, are rendered as
+// well. Opaque strings in Set or Unset with such glyphs are drawn
+// directly instead: copying the surface would also overwrite the pixels
+// around the overhanging glyphs.
+
+class OledTextSurfaceCache
+{
+public:
+
+    static constexpr size_t DefaultBudget{4096};
+
+    explicit OledTextSurfaceCache(size_t budget = DefaultBudget);
+
+    void
+    draw(
+        const OledPoint& p,
+        const OledTypeface& typeface,
+        const std::string& string,
+        PixelStyle style,
+        OledPixel& pixels,
+        GlyphMode mode = GlyphMode::Opaque);
+
+    void clear();
+
+    size_t budget() const { return budget_; }
+    size_t bytes() const { return bytes_; }
+    size_t size() const { return entries_.size(); }
+
+    // How often draw() found the string already rendered, and how often
+    // it had to render it, since construction or resetCounters().
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    void resetCounters();
+
+private:
+
+    struct Entry
+    {
+        size_t hash;
+        const OledTypeface* typeface;
+        std::string string;
+        PixelStyle style;
+        GlyphMode mode;
+        OledPoint origin;
+        OledSurface surface;
+    };
+
+    // Most recently used first.
+
+    using Entries = std::list<Entry>;
+
+    void evict();
+
+    size_t budget_;
+    size_t bytes_;
+    uint64_t hits_;
+    uint64_t misses_;
+    Entries entries_;
+    std::unordered_multimap<size_t, Entries::iterator> index_;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
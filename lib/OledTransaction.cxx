@@ -0,0 +1,72 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include "OledTransaction.h"
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledTransaction::clear()
+{
+    bytes_.clear();
+    segments_.clear();
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledTransaction::addCommands(
+    const OledCommandBatch& commands)
+{
+    add(Type::Command, commands.data(), commands.size());
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledTransaction::addData(
+    const uint8_t* data,
+    int length)
+{
+    add(Type::Data, data, length);
+}
+
+//------------------------------------------------------------------------
+
+void
+SSD1306::OledTransaction::add(
+    Type type,
+    const uint8_t* bytes,
+    int length)
+{
+    if (length > 0)
+    {
+        segments_.push_back(Segment{type, size(), length});
+        bytes_.insert(bytes_.end(), bytes, bytes + length);
+    }
+}
+
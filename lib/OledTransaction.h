@@ -0,0 +1,96 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#ifndef OLED_TRANSACTION_H
+#define OLED_TRANSACTION_H
+
+//------------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+#include "OledCommandBatch.h"
+
+//------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//------------------------------------------------------------------------
+
+// An ordered sequence of command and data segments that a device sends
+// to the controller as one transfer.
+
+class OledTransaction
+{
+public:
+
+    enum class Type
+    {
+        Command,
+        Data
+    };
+
+    struct Segment
+    {
+        Type type;
+        int offset;
+        int length;
+    };
+
+    void clear();
+
+    void addCommands(const OledCommandBatch& commands);
+    void addData(const uint8_t* data, int length);
+
+    bool empty() const { return segments_.empty(); }
+
+    const std::vector<Segment>& segments() const { return segments_; }
+
+    const uint8_t*
+    data(const Segment& segment) const
+    {
+        return bytes_.data() + segment.offset;
+    }
+
+    int size() const { return bytes_.size(); }
+
+private:
+
+    void add(Type type, const uint8_t* bytes, int length);
+
+    std::vector<uint8_t> bytes_;
+    std::vector<Segment> segments_;
+};
+
+//------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//------------------------------------------------------------------------
+
+#endif
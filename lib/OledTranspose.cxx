@@ -0,0 +1,426 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#define OLED_TRANSPOSE_SSE2
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define OLED_TRANSPOSE_NEON
+#if defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+#include <chrono>
+#include <string>
+
+#include "OledTranspose.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// Transpose the 8x8 bit matrix held in a 64 bit word, with row i in
+// byte i and column j in bit j of each byte, using three rounds of
+// swapping blocks across the diagonal.
+
+uint64_t
+transpose8x8(
+    uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+
+    return x;
+}
+
+//-------------------------------------------------------------------------
+
+// The leftmost pixel of a row is its most significant bit, so column c
+// of the tile is bit 7 - c of each row. That puts column c in byte
+// 7 - c of the transposed word.
+
+void
+rowsToPageScalar(
+    const uint8_t* rows,
+    int stride,
+    uint8_t* page)
+{
+    uint64_t x{0};
+
+    for (auto i = 0 ; i < 8 ; ++i)
+    {
+        x |= static_cast<uint64_t>(rows[i * stride]) << (8 * i);
+    }
+
+    x = transpose8x8(x);
+
+    for (auto c = 0 ; c < 8 ; ++c)
+    {
+        page[c] = static_cast<uint8_t>(x >> (8 * (7 - c)));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+pageToRowsScalar(
+    const uint8_t* page,
+    uint8_t* rows,
+    int stride)
+{
+    uint64_t x{0};
+
+    for (auto c = 0 ; c < 8 ; ++c)
+    {
+        x |= static_cast<uint64_t>(page[c]) << (8 * (7 - c));
+    }
+
+    x = transpose8x8(x);
+
+    for (auto i = 0 ; i < 8 ; ++i)
+    {
+        rows[i * stride] = static_cast<uint8_t>(x >> (8 * i));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+#ifdef OLED_TRANSPOSE_SSE2
+
+// movemask collects the most significant bit of each byte. With row i
+// in byte i that is column 0 of the tile; doubling each byte then moves
+// the next column up into the most significant bit.
+
+bool
+hasSSE2()
+{
+    return __builtin_cpu_supports("sse2");
+}
+
+//-------------------------------------------------------------------------
+
+__attribute__((target("sse2")))
+void
+rowsToPageSSE2(
+    const uint8_t* rows,
+    int stride,
+    uint8_t* page)
+{
+    uint64_t bytes{0};
+
+    for (auto i = 0 ; i < 8 ; ++i)
+    {
+        bytes |= static_cast<uint64_t>(rows[i * stride]) << (8 * i);
+    }
+
+    auto x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bytes));
+
+    for (auto c = 0 ; c < 8 ; ++c)
+    {
+        page[c] = static_cast<uint8_t>(_mm_movemask_epi8(x));
+        x = _mm_add_epi8(x, x);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// Here byte c holds column 7 - c, so that the bits that movemask gathers
+// come out with the leftmost column in the most significant bit. Row 7
+// is the top bit of each byte, so the rows come out bottom first.
+
+__attribute__((target("sse2")))
+void
+pageToRowsSSE2(
+    const uint8_t* page,
+    uint8_t* rows,
+    int stride)
+{
+    uint64_t bytes{0};
+
+    for (auto c = 0 ; c < 8 ; ++c)
+    {
+        bytes |= static_cast<uint64_t>(page[c]) << (8 * (7 - c));
+    }
+
+    auto x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&bytes));
+
+    for (auto i = 7 ; i >= 0 ; --i)
+    {
+        rows[i * stride] = static_cast<uint8_t>(_mm_movemask_epi8(x));
+        x = _mm_add_epi8(x, x);
+    }
+}
+
+#endif
+
+//-------------------------------------------------------------------------
+
+#ifdef OLED_TRANSPOSE_NEON
+
+bool
+hasNEON()
+{
+#if defined(__arm__)
+    return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#else
+    return true;
+#endif
+}
+
+//-------------------------------------------------------------------------
+
+// For each output byte, vtst picks out the lanes that have the wanted
+// bit set, a weight per lane turns them into bits of the result, and
+// three rounds of pairwise adds sum all eight outputs at once.
+
+uint8x8_t
+gather(
+    uint8x8_t x,
+    const uint8_t* tests,
+    uint8x8_t weights)
+{
+    uint8x8_t t[8];
+
+    for (auto i = 0 ; i < 8 ; ++i)
+    {
+        t[i] = vand_u8(vtst_u8(x, vdup_n_u8(tests[i])), weights);
+    }
+
+    auto t01 = vpadd_u8(t[0], t[1]);
+    auto t23 = vpadd_u8(t[2], t[3]);
+    auto t45 = vpadd_u8(t[4], t[5]);
+    auto t67 = vpadd_u8(t[6], t[7]);
+
+    return vpadd_u8(vpadd_u8(t01, t23), vpadd_u8(t45, t67));
+}
+
+//-------------------------------------------------------------------------
+
+constexpr uint8_t LowFirst[8]{0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+constexpr uint8_t HighFirst[8]{0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+
+//-------------------------------------------------------------------------
+
+void
+rowsToPageNEON(
+    const uint8_t* rows,
+    int stride,
+    uint8_t* page)
+{
+    uint8_t bytes[8];
+
+    for (auto i = 0 ; i < 8 ; ++i)
+    {
+        bytes[i] = rows[i * stride];
+    }
+
+    auto x = gather(vld1_u8(bytes), HighFirst, vld1_u8(LowFirst));
+
+    vst1_u8(page, x);
+}
+
+//-------------------------------------------------------------------------
+
+void
+pageToRowsNEON(
+    const uint8_t* page,
+    uint8_t* rows,
+    int stride)
+{
+    uint8_t bytes[8];
+
+    auto x = gather(vld1_u8(page), LowFirst, vld1_u8(HighFirst));
+
+    vst1_u8(bytes, x);
+
+    for (auto i = 0 ; i < 8 ; ++i)
+    {
+        rows[i * stride] = bytes[i];
+    }
+}
+
+#endif
+
+//-------------------------------------------------------------------------
+
+// Time a kernel function over enough tiles to swamp the clock's
+// resolution, taking the best of a few tries to ride out interruptions.
+
+template<typename CONVERT>
+double
+measure(
+    CONVERT convert)
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int Tiles{1024};
+    constexpr int Tries{3};
+
+    static uint8_t rows[8 * Tiles];
+    static uint8_t page[8 * Tiles];
+
+    double best{0};
+
+    for (auto attempt = 0 ; attempt < Tries ; ++attempt)
+    {
+        auto start = Clock::now();
+
+        for (auto tile = 0 ; tile < Tiles ; ++tile)
+        {
+            convert(rows + tile, Tiles, page + (8 * tile));
+        }
+
+        std::chrono::duration<double> elapsed = Clock::now() - start;
+
+        if ((attempt == 0) || (elapsed.count() < best))
+        {
+            best = elapsed.count();
+        }
+    }
+
+    return best;
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledTransposeKernel
+selectKernel()
+{
+    static std::string name;
+
+    auto kernels = SSD1306::transposeKernels();
+    auto selected = kernels.front();
+
+    if (kernels.size() == 1)
+    {
+        return selected;
+    }
+
+    double toPageBest{0};
+    double toRowsBest{0};
+    std::string toPageName;
+    std::string toRowsName;
+
+    for (auto& kernel : kernels)
+    {
+        auto toPage = measure([&kernel](uint8_t* rows,
+                                        int stride,
+                                        uint8_t* page)
+        {
+            kernel.rowsToPage(rows, stride, page);
+        });
+
+        auto toRows = measure([&kernel](uint8_t* rows,
+                                        int stride,
+                                        uint8_t* page)
+        {
+            kernel.pageToRows(page, rows, stride);
+        });
+
+        if (toPageName.empty() || (toPage < toPageBest))
+        {
+            toPageBest = toPage;
+            toPageName = kernel.name;
+            selected.rowsToPage = kernel.rowsToPage;
+        }
+
+        if (toRowsName.empty() || (toRows < toRowsBest))
+        {
+            toRowsBest = toRows;
+            toRowsName = kernel.name;
+            selected.pageToRows = kernel.pageToRows;
+        }
+    }
+
+    name = toPageName;
+
+    if (toRowsName != toPageName)
+    {
+        name += "/" + toRowsName;
+    }
+
+    selected.name = name.c_str();
+
+    return selected;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+const SSD1306::OledTransposeKernel&
+SSD1306::transposeKernel()
+{
+    static const OledTransposeKernel kernel = selectKernel();
+
+    return kernel;
+}
+
+//-------------------------------------------------------------------------
+
+std::vector<SSD1306::OledTransposeKernel>
+SSD1306::transposeKernels()
+{
+    std::vector<OledTransposeKernel> kernels
+    {
+        { "scalar", rowsToPageScalar, pageToRowsScalar }
+    };
+
+#ifdef OLED_TRANSPOSE_SSE2
+    if (hasSSE2())
+    {
+        kernels.push_back({ "sse2", rowsToPageSSE2, pageToRowsSSE2 });
+    }
+#endif
+
+#ifdef OLED_TRANSPOSE_NEON
+    if (hasNEON())
+    {
+        kernels.push_back({ "neon", rowsToPageNEON, pageToRowsNEON });
+    }
+#endif
+
+    return kernels;
+}
+
@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_TRANSPOSE_H
+#define OLED_TRANSPOSE_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// Conversion of an 8x8 pixel tile between the two layouts.
+//
+// rowsToPage - rows are eight row-major bytes, stride bytes apart, with
+//              the leftmost pixel in the most significant bit. page is
+//              filled with the eight page-major bytes of the same tile,
+//              one per column, top row in the least significant bit.
+// pageToRows - the reverse.
+//
+// There is a portable scalar kernel and, where the processor has them,
+// SSE2 and NEON kernels; transposeKernels() lists those that the
+// processor the program is running on supports. The first call to
+// transposeKernel() times each of them briefly and returns the fastest
+// function for each direction.
+
+struct OledTransposeKernel
+{
+    const char* name;
+    void (*rowsToPage)(const uint8_t* rows, int stride, uint8_t* page);
+    void (*pageToRows)(const uint8_t* page, uint8_t* rows, int stride);
+};
+
+//-------------------------------------------------------------------------
+
+const OledTransposeKernel& transposeKernel();
+
+std::vector<OledTransposeKernel> transposeKernels();
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,87 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#include "OledText.h"
+#include "OledTypeface.h"
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledTypeface::~OledTypeface() = default;
+
+//-------------------------------------------------------------------------
+
+uint32_t
+SSD1306::OledTypeface::invalidByte(
+    uint8_t) const
+{
+    return ReplacementCharacter;
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledOverhang
+SSD1306::OledTypeface::overhang(
+    uint32_t) const
+{
+    return OledOverhang{0, 0, 0, 0};
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledFixedTypeface::OledFixedTypeface(
+    int width,
+    int height,
+    DrawChar drawChar)
+:
+    width_{width},
+    height_{height},
+    drawChar_{drawChar}
+{
+}
+
+//-------------------------------------------------------------------------
+
+uint32_t
+SSD1306::OledFixedTypeface::invalidByte(
+    uint8_t byte) const
+{
+    return fromCodePage437(byte);
+}
+
+//-------------------------------------------------------------------------
+
+SSD1306::OledPoint
+SSD1306::OledFixedTypeface::drawChar(
+    const OledPoint& p,
+    uint32_t code,
+    PixelStyle style,
+    OledPixel& pixels,
+    GlyphMode mode) const
+{
+    return drawChar_(p, codePage437(code), style, pixels, mode);
+}
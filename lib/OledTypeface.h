@@ -0,0 +1,137 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+#ifndef OLED_TYPEFACE_H
+#define OLED_TYPEFACE_H
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+
+#include "OledGlyph.h"
+#include "OledPixel.h"
+#include "point.h"
+
+//-------------------------------------------------------------------------
+
+namespace SSD1306
+{
+
+//-------------------------------------------------------------------------
+
+// How many pixels beyond each side of a box some drawing may reach.
+
+struct OledOverhang
+{
+    int left;
+    int top;
+    int right;
+    int bottom;
+};
+
+//-------------------------------------------------------------------------
+
+// What text measurement and layout need from a font: how far each code
+// point advances the pen, how far apart lines are, how to draw one code
+// point with p at the top left of its cell, and which code point stands
+// for a byte that is not UTF-8.
+
+class OledTypeface
+{
+public:
+
+    virtual ~OledTypeface() = 0;
+
+    virtual int advance(uint32_t code) const = 0;
+    virtual int lineHeight() const = 0;
+
+    // ReplacementCharacter unless the typeface has a better reading.
+
+    virtual uint32_t invalidByte(uint8_t byte) const;
+
+    // How far drawChar() may draw outside the cell, advance(code) wide
+    // and lineHeight() high. None unless the glyphs overhang their cells.
+
+    virtual OledOverhang overhang(uint32_t code) const;
+
+    virtual OledPoint
+    drawChar(
+        const OledPoint& p,
+        uint32_t code,
+        PixelStyle style,
+        OledPixel& pixels,
+        GlyphMode mode = GlyphMode::Opaque) const = 0;
+};
+
+//-------------------------------------------------------------------------
+
+// One of the fixed 8 pixel wide code page 437 fonts as a typeface. Code
+// points are mapped to code page 437 as by the drawString8xN() functions,
+// which also draw a byte that is not UTF-8 as its code page 437 glyph.
+
+class OledFixedTypeface
+:
+    public OledTypeface
+{
+public:
+
+    using DrawChar = OledPoint (*)(const OledPoint& p,
+                                   uint8_t c,
+                                   PixelStyle style,
+                                   OledPixel& pixels,
+                                   GlyphMode mode);
+
+    OledFixedTypeface(int width, int height, DrawChar drawChar);
+
+    int advance(uint32_t) const override { return width_; }
+    int lineHeight() const override { return height_; }
+
+    uint32_t invalidByte(uint8_t byte) const override;
+
+    OledPoint
+    drawChar(
+        const OledPoint& p,
+        uint32_t code,
+        PixelStyle style,
+        OledPixel& pixels,
+        GlyphMode mode = GlyphMode::Opaque) const override;
+
+private:
+
+    int width_;
+    int height_;
+    DrawChar drawChar_;
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace SSD1306
+
+//-------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,235 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+
+// Run an SSD1306 emulator on the transfers written by
+// SSD1306::OledI2CStreamDevice, for programs that drive a display from
+// another process.
+//
+//     oledemulator [-f prefix] [input]
+//
+// input is a file or named pipe (default standard input). At the end of
+// the stream the last frame is written to standard output as a PBM. With
+// -f, every transfer that carries display data also writes a frame to
+// prefixNNNNNN.pbm.
+
+#include <getopt.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "OledEmulator.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// Read one little endian 16 bit value, returning false at the end of the
+// stream.
+
+bool
+read16(
+    std::istream& input,
+    int& value)
+{
+    uint8_t bytes[2];
+
+    if (not input.read(reinterpret_cast<char*>(bytes), sizeof(bytes)))
+    {
+        return false;
+    }
+
+    value = bytes[0] | (bytes[1] << 8);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+// Feed one transfer to the emulator and return true if any of its
+// messages carried display data.
+
+bool
+transfer(
+    std::istream& input,
+    SSD1306::OledEmulator& emulator)
+{
+    int count;
+
+    if (not read16(input, count))
+    {
+        throw std::runtime_error("stream ends inside a transfer");
+    }
+
+    std::vector<uint8_t> message;
+    auto hasData = false;
+
+    for (auto i = 0 ; i < count ; ++i)
+    {
+        int length;
+
+        if (not read16(input, length))
+        {
+            throw std::runtime_error("stream ends inside a transfer");
+        }
+
+        message.resize(length);
+
+        if (not input.read(reinterpret_cast<char*>(message.data()), length))
+        {
+            throw std::runtime_error("stream ends inside a message");
+        }
+
+        if ((length > 0) && ((message[0] & 0x40) != 0))
+        {
+            hasData = true;
+        }
+
+        emulator.i2cMessage(message.data(), length);
+    }
+
+    return hasData;
+}
+
+//-------------------------------------------------------------------------
+
+void
+usage(
+    const char* name)
+{
+    std::cerr << "Usage: " << name << " [-f prefix] [input]\n";
+    std::cerr << "\n";
+    std::cerr << "    -f - write each frame to prefixNNNNNN.pbm\n";
+    std::cerr << "\n";
+    std::cerr << "input is a file or named pipe (default standard input)\n";
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    std::string prefix;
+
+    int opt;
+
+    while ((opt = ::getopt(argc, argv, "f:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+
+            prefix = optarg;
+            break;
+
+        default:
+
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind > 1)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        std::unique_ptr<std::ifstream> file;
+
+        if (optind < argc)
+        {
+            file.reset(new std::ifstream{argv[optind], std::ios::binary});
+
+            if (not *file)
+            {
+                throw std::runtime_error(std::string("cannot open ") +
+                                         argv[optind]);
+            }
+        }
+
+        std::istream& input = file ? *file : std::cin;
+
+        SSD1306::OledEmulator emulator;
+        auto frame = 0;
+
+        while (input.peek() != std::char_traits<char>::eof())
+        {
+            if (transfer(input, emulator) && (not prefix.empty()))
+            {
+                std::ostringstream name;
+                name << prefix
+                     << std::setw(6) << std::setfill('0') << frame++
+                     << ".pbm";
+
+                std::ofstream out{name.str(), std::ios::binary};
+                emulator.writePbm(out);
+
+                if (not out)
+                {
+                    throw std::runtime_error("cannot write " + name.str());
+                }
+            }
+        }
+
+        if (emulator.unknownCommands() > 0)
+        {
+            std::cerr << emulator.unknownCommands()
+                      << " unknown command bytes\n";
+        }
+
+        emulator.writePbm(std::cout);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
@@ -0,0 +1,784 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2017 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+
+// Convert a BDF or PSF (version 1 or 2) bitmap font to the binary format
+// read by SSD1306::OledFont.
+//
+//     oledfont [-f first] [-l last] input output
+//
+// -f and -l keep only the code points from first to last, so that a font
+// for a display that only shows digits need not carry the whole of
+// Unicode.
+
+#include <getopt.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "OledFont.h"
+
+//-------------------------------------------------------------------------
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// A glyph while it is being converted. rows are row-major, (width + 7) / 8
+// bytes per row, leftmost pixel in the most significant bit.
+
+struct Glyph
+{
+    uint32_t code;
+    int width;
+    int height;
+    int left;
+    int top;
+    int advance;
+    std::vector<uint8_t> rows;
+};
+
+struct Font
+{
+    int ascent;
+    int descent;
+    uint32_t defaultCode;
+    std::vector<Glyph> glyphs;
+};
+
+//-------------------------------------------------------------------------
+
+int
+bytesPerRow(
+    int width)
+{
+    return (width + 7) / 8;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+isSet(
+    const Glyph& glyph,
+    int x,
+    int y)
+{
+    auto byte = glyph.rows[(y * bytesPerRow(glyph.width)) + (x / 8)];
+
+    return (byte & (0x80 >> (x % 8))) != 0;
+}
+
+//-------------------------------------------------------------------------
+
+// Cut the bitmap down to the smallest box holding every set pixel. The
+// pen position and advance are unchanged, so the glyph draws the same.
+
+void
+trim(
+    Glyph& glyph)
+{
+    auto left = glyph.width;
+    auto right = -1;
+    auto top = glyph.height;
+    auto bottom = -1;
+
+    for (auto y = 0 ; y < glyph.height ; ++y)
+    {
+        for (auto x = 0 ; x < glyph.width ; ++x)
+        {
+            if (isSet(glyph, x, y))
+            {
+                left = std::min(left, x);
+                right = std::max(right, x);
+                top = std::min(top, y);
+                bottom = std::max(bottom, y);
+            }
+        }
+    }
+
+    Glyph trimmed{glyph.code, 0, 0, 0, 0, glyph.advance, {}};
+
+    if (right >= 0)
+    {
+        trimmed.width = right - left + 1;
+        trimmed.height = bottom - top + 1;
+        trimmed.left = glyph.left + left;
+        trimmed.top = glyph.top - top;
+        trimmed.rows.resize(bytesPerRow(trimmed.width) * trimmed.height);
+
+        for (auto y = 0 ; y < trimmed.height ; ++y)
+        {
+            for (auto x = 0 ; x < trimmed.width ; ++x)
+            {
+                if (isSet(glyph, left + x, top + y))
+                {
+                    auto index = (y * bytesPerRow(trimmed.width)) + (x / 8);
+                    trimmed.rows[index] |= 0x80 >> (x % 8);
+                }
+            }
+        }
+    }
+
+    glyph = std::move(trimmed);
+}
+
+//-------------------------------------------------------------------------
+
+// BDF - the X11 text format. Only the properties needed for drawing are
+// read; glyphs with no standard encoding are skipped.
+
+Font
+readBdf(
+    const std::vector<uint8_t>& file)
+{
+    std::istringstream input{std::string(file.begin(), file.end())};
+
+    Font font{0, 0, '?', {}};
+    bool hasAscent = false;
+    bool hasDescent = false;
+    bool hasDefault = false;
+    int boundingHeight = 0;
+    int boundingY = 0;
+    int fontAdvance = -1;
+
+    Glyph glyph{0, 0, 0, 0, 0, -1, {}};
+    bool inChar = false;
+    int encoding = -1;
+    int row = -1;
+
+    std::string line;
+
+    while (std::getline(input, line))
+    {
+        std::istringstream words{line};
+        std::string keyword;
+        words >> keyword;
+
+        if (row >= 0)
+        {
+            if (keyword == "ENDCHAR")
+            {
+                if (encoding >= 0)
+                {
+                    if (glyph.advance < 0)
+                    {
+                        glyph.advance = (fontAdvance < 0)
+                                      ? glyph.left + glyph.width
+                                      : fontAdvance;
+                    }
+
+                    glyph.code = encoding;
+                    font.glyphs.push_back(glyph);
+                }
+
+                inChar = false;
+                row = -1;
+            }
+            else if (row < glyph.height)
+            {
+                auto stride = bytesPerRow(glyph.width);
+
+                for (auto i = 0 ; i < stride ; ++i)
+                {
+                    auto hex = keyword.substr(i * 2, 2);
+
+                    if (hex.size() == 2)
+                    {
+                        glyph.rows[(row * stride) + i] =
+                            std::stoi(hex, nullptr, 16);
+                    }
+                }
+
+                ++row;
+            }
+        }
+        else if (keyword == "FONTBOUNDINGBOX")
+        {
+            int width;
+            int x;
+            words >> width >> boundingHeight >> x >> boundingY;
+        }
+        else if (keyword == "FONT_ASCENT")
+        {
+            words >> font.ascent;
+            hasAscent = true;
+        }
+        else if (keyword == "FONT_DESCENT")
+        {
+            words >> font.descent;
+            hasDescent = true;
+        }
+        else if (keyword == "DEFAULT_CHAR")
+        {
+            words >> font.defaultCode;
+            hasDefault = true;
+        }
+        else if (keyword == "STARTCHAR")
+        {
+            glyph = Glyph{0, 0, 0, 0, 0, -1, {}};
+            inChar = true;
+            encoding = -1;
+        }
+        else if (keyword == "ENCODING")
+        {
+            words >> encoding;
+        }
+        else if (keyword == "DWIDTH")
+        {
+            // Outside STARTCHAR, DWIDTH applies to every glyph.
+
+            words >> (inChar ? glyph.advance : fontAdvance);
+        }
+        else if (keyword == "BBX")
+        {
+            int y;
+            words >> glyph.width >> glyph.height >> glyph.left >> y;
+            glyph.top = y + glyph.height;
+        }
+        else if (keyword == "BITMAP")
+        {
+            glyph.rows.assign(bytesPerRow(glyph.width) * glyph.height, 0);
+            row = 0;
+        }
+    }
+
+    if (not hasAscent)
+    {
+        font.ascent = boundingHeight + boundingY;
+    }
+
+    if (not hasDescent)
+    {
+        font.descent = -boundingY;
+    }
+
+    if (not hasDefault)
+    {
+        font.defaultCode = '?';
+    }
+
+    return font;
+}
+
+//-------------------------------------------------------------------------
+
+uint32_t
+little16(
+    const uint8_t* bytes)
+{
+    return bytes[0] | (bytes[1] << 8);
+}
+
+//-------------------------------------------------------------------------
+
+uint32_t
+little32(
+    const uint8_t* bytes)
+{
+    return uint32_t(bytes[0])
+         | (uint32_t(bytes[1]) << 8)
+         | (uint32_t(bytes[2]) << 16)
+         | (uint32_t(bytes[3]) << 24);
+}
+
+//-------------------------------------------------------------------------
+
+// Decode one UTF-8 character from a PSF2 unicode table, advancing bytes.
+
+uint32_t
+utf8(
+    const uint8_t*& bytes,
+    const uint8_t* end)
+{
+    uint32_t code = *bytes++;
+    int more = 0;
+
+    if (code >= 0xF0)
+    {
+        code &= 0x07;
+        more = 3;
+    }
+    else if (code >= 0xE0)
+    {
+        code &= 0x0F;
+        more = 2;
+    }
+    else if (code >= 0xC0)
+    {
+        code &= 0x1F;
+        more = 1;
+    }
+
+    while ((more-- > 0) && (bytes < end))
+    {
+        code = (code << 6) | (*bytes++ & 0x3F);
+    }
+
+    return code;
+}
+
+//-------------------------------------------------------------------------
+
+// PSF - the Linux console format. Every glyph is the same size, so the
+// font is all ascent and each glyph advances by its width. Without a
+// unicode table, glyph n is code point n.
+
+Font
+readPsf(
+    const std::vector<uint8_t>& file)
+{
+    auto size = file.size();
+    auto bytes = file.data();
+
+    int count;
+    int width;
+    int height;
+    size_t headerSize;
+    size_t glyphSize;
+    bool hasTable;
+    bool psf2 = (bytes[0] == 0x72);
+
+    if (psf2)
+    {
+        if (size < 32)
+        {
+            throw std::runtime_error("truncated PSF2 header");
+        }
+
+        headerSize = little32(bytes + 8);
+        hasTable = (little32(bytes + 12) & 0x01) != 0;
+        count = little32(bytes + 16);
+        glyphSize = little32(bytes + 20);
+        height = little32(bytes + 24);
+        width = little32(bytes + 28);
+    }
+    else
+    {
+        headerSize = 4;
+        hasTable = (bytes[2] & 0x06) != 0;
+        count = (bytes[2] & 0x01) ? 512 : 256;
+        glyphSize = bytes[3];
+        height = bytes[3];
+        width = 8;
+    }
+
+    auto stride = bytesPerRow(width);
+
+    if ((width <= 0) ||
+        (height <= 0) ||
+        (glyphSize < size_t(stride * height)) ||
+        (headerSize + (count * glyphSize) > size))
+    {
+        throw std::runtime_error("truncated or inconsistent PSF font");
+    }
+
+    Font font{height, 0, '?', {}};
+    std::vector<std::vector<uint32_t>> codes(count);
+
+    if (hasTable)
+    {
+        auto table = bytes + headerSize + (count * glyphSize);
+        auto end = bytes + size;
+
+        for (auto index = 0 ; (index < count) && (table < end) ; ++index)
+        {
+            bool sequence = false;
+
+            while (table < end)
+            {
+                uint32_t code;
+
+                if (psf2)
+                {
+                    // PSF2 marks the ends of entries and sequences with
+                    // bytes that can't start a UTF-8 character.
+
+                    if (*table == 0xFF)
+                    {
+                        code = 0xFFFF;
+                        ++table;
+                    }
+                    else if (*table == 0xFE)
+                    {
+                        code = 0xFFFE;
+                        ++table;
+                    }
+                    else
+                    {
+                        code = utf8(table, end);
+                    }
+                }
+                else if (table + 1 < end)
+                {
+                    code = little16(table);
+                    table += 2;
+                }
+                else
+                {
+                    break;
+                }
+
+                if (code == 0xFFFF)
+                {
+                    break;
+                }
+
+                // Sequences of combining characters can't be represented
+                // by one glyph per code point, so are dropped.
+
+                if (code == 0xFFFE)
+                {
+                    sequence = true;
+                }
+                else if (not sequence)
+                {
+                    codes[index].push_back(code);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (auto index = 0 ; index < count ; ++index)
+        {
+            codes[index].push_back(index);
+        }
+    }
+
+    for (auto index = 0 ; index < count ; ++index)
+    {
+        auto start = bytes + headerSize + (index * glyphSize);
+
+        for (auto code : codes[index])
+        {
+            font.glyphs.push_back(Glyph{code,
+                                        width,
+                                        height,
+                                        0,
+                                        height,
+                                        width,
+                                        {start, start + (stride * height)}});
+        }
+    }
+
+    return font;
+}
+
+//-------------------------------------------------------------------------
+
+void
+put16(
+    std::vector<uint8_t>& output,
+    uint32_t value)
+{
+    output.push_back(value & 0xFF);
+    output.push_back((value >> 8) & 0xFF);
+}
+
+//-------------------------------------------------------------------------
+
+void
+put32(
+    std::vector<uint8_t>& output,
+    uint32_t value)
+{
+    put16(output, value & 0xFFFF);
+    put16(output, value >> 16);
+}
+
+//-------------------------------------------------------------------------
+
+void
+check(
+    bool ok,
+    const Glyph& glyph,
+    const char* what)
+{
+    if (not ok)
+    {
+        throw std::runtime_error("glyph "
+                                 + std::to_string(glyph.code)
+                                 + ": "
+                                 + what
+                                 + " out of range");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::vector<uint8_t>
+write(
+    Font& font,
+    uint32_t first,
+    uint32_t last)
+{
+    auto& glyphs = font.glyphs;
+
+    glyphs.erase(std::remove_if(glyphs.begin(),
+                                glyphs.end(),
+                                [=](const Glyph& glyph)
+                                {
+                                    return (glyph.code < first) ||
+                                           (glyph.code > last);
+                                }),
+                 glyphs.end());
+
+    // The first glyph given for a code point wins.
+
+    std::stable_sort(glyphs.begin(),
+                     glyphs.end(),
+                     [](const Glyph& lhs, const Glyph& rhs)
+                     {
+                         return lhs.code < rhs.code;
+                     });
+
+    glyphs.erase(std::unique(glyphs.begin(),
+                             glyphs.end(),
+                             [](const Glyph& lhs, const Glyph& rhs)
+                             {
+                                 return lhs.code == rhs.code;
+                             }),
+                 glyphs.end());
+
+    // Consecutive code points share a range.
+
+    struct Range
+    {
+        uint32_t first;
+        uint32_t count;
+        uint32_t glyph;
+    };
+
+    std::vector<Range> ranges;
+
+    for (size_t index = 0 ; index < glyphs.size() ; ++index)
+    {
+        auto code = glyphs[index].code;
+
+        if (ranges.empty() ||
+            (ranges.back().first + ranges.back().count != code))
+        {
+            ranges.push_back(Range{code, 0, uint32_t(index)});
+        }
+
+        ++ranges.back().count;
+    }
+
+    // Glyphs that look the same (the same letter under several code
+    // points, say) share a bitmap.
+
+    std::vector<uint8_t> bitmaps;
+    std::map<std::vector<uint8_t>, uint32_t> offsets;
+    std::vector<uint8_t> records;
+
+    for (auto& glyph : glyphs)
+    {
+        trim(glyph);
+
+        check(glyph.width <= 255, glyph, "width");
+        check(glyph.height <= 255, glyph, "height");
+        check((glyph.left >= -128) && (glyph.left <= 127), glyph, "left");
+        check((glyph.top >= -128) && (glyph.top <= 127), glyph, "top");
+        check((glyph.advance >= 0) && (glyph.advance <= 255),
+              glyph,
+              "advance");
+
+        auto key = glyph.rows;
+        key.push_back(glyph.width);
+        key.push_back(glyph.height);
+
+        auto found = offsets.find(key);
+
+        if (found == offsets.end())
+        {
+            found = offsets.emplace(key, bitmaps.size()).first;
+            bitmaps.insert(bitmaps.end(),
+                           glyph.rows.begin(),
+                           glyph.rows.end());
+        }
+
+        put32(records, found->second);
+        records.push_back(glyph.width);
+        records.push_back(glyph.height);
+        records.push_back(uint8_t(glyph.left));
+        records.push_back(uint8_t(glyph.top));
+        records.push_back(glyph.advance);
+        records.insert(records.end(), 3, 0);
+    }
+
+    std::vector<uint8_t> output(std::begin(SSD1306::OledFontFormat::Magic),
+                                std::end(SSD1306::OledFontFormat::Magic));
+
+    put16(output, SSD1306::OledFontFormat::Version);
+    put16(output, SSD1306::OledFontFormat::HeaderSize);
+    put16(output, uint16_t(font.ascent));
+    put16(output, uint16_t(font.descent));
+    put32(output, font.defaultCode);
+    put32(output, ranges.size());
+    put32(output, glyphs.size());
+    put32(output, bitmaps.size());
+    put32(output, 0);
+
+    for (const auto& range : ranges)
+    {
+        put32(output, range.first);
+        put32(output, range.count);
+        put32(output, range.glyph);
+    }
+
+    output.insert(output.end(), records.begin(), records.end());
+    output.insert(output.end(), bitmaps.begin(), bitmaps.end());
+
+    return output;
+}
+
+//-------------------------------------------------------------------------
+
+void
+usage(
+    const char* name)
+{
+    std::cerr << "Usage: " << name << " [-f first] [-l last] input output\n";
+    std::cerr << "\n";
+    std::cerr << "    -f - first code point to keep (default 0)\n";
+    std::cerr << "    -l - last code point to keep (default all)\n";
+    std::cerr << "\n";
+    std::cerr << "input may be a BDF, PSF1 or PSF2 font\n";
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    uint32_t first = 0;
+    uint32_t last = UINT32_MAX;
+
+    int opt;
+
+    while ((opt = ::getopt(argc, argv, "f:l:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+
+            first = std::strtoul(optarg, nullptr, 0);
+            break;
+
+        case 'l':
+
+            last = std::strtoul(optarg, nullptr, 0);
+            break;
+
+        default:
+
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc - optind != 2)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        std::string inputName{argv[optind]};
+        std::string outputName{argv[optind + 1]};
+
+        std::ifstream input{inputName, std::ios::binary};
+
+        if (not input)
+        {
+            throw std::runtime_error("cannot open " + inputName);
+        }
+
+        std::vector<uint8_t> file{std::istreambuf_iterator<char>(input),
+                                  std::istreambuf_iterator<char>()};
+
+        Font font;
+
+        if ((file.size() >= 4) &&
+            (((file[0] == 0x36) && (file[1] == 0x04)) ||
+             ((file[0] == 0x72) && (file[1] == 0xB5) &&
+              (file[2] == 0x4A) && (file[3] == 0x86))))
+        {
+            font = readPsf(file);
+        }
+        else if ((file.size() >= 9) &&
+                 (std::memcmp(file.data(), "STARTFONT", 9) == 0))
+        {
+            font = readBdf(file);
+        }
+        else
+        {
+            throw std::runtime_error(inputName + " is not a BDF or PSF font");
+        }
+
+        auto output = write(font, first, last);
+
+        std::ofstream out{outputName, std::ios::binary};
+
+        out.write(reinterpret_cast<const char*>(output.data()),
+                  output.size());
+
+        if (not out)
+        {
+            throw std::runtime_error("cannot write " + outputName);
+        }
+
+        std::cout << outputName << ": "
+                  << font.glyphs.size() << " glyphs, "
+                  << output.size() << " bytes\n";
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}